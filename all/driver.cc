@@ -0,0 +1,63 @@
+#include "all/driver.h"
+
+#include <algorithm>
+
+#include "absl/strings/str_format.h"
+
+namespace {
+
+double Milliseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+Driver::Driver(int threads) : pool_(threads) {}
+
+void Driver::Run() {
+  run_start_ = Clock::now();
+  for (const auto& task : parse_tasks_) pool_.Schedule(task);
+  {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(
+        +[](int64_t* unfinished) { return *unfinished == 0; },
+        &unfinished_));
+  }
+  Report(Clock::now() - run_start_);
+}
+
+void Driver::RunTask(const std::string& day, const std::string& task,
+                     const std::function<std::string()>& fn) {
+  TaskRecord record;
+  record.day = day;
+  record.task = task;
+  Clock::time_point start = Clock::now();
+  record.answer = fn();
+  Clock::time_point end = Clock::now();
+  record.start = start - run_start_;
+  record.wall = end - start;
+  absl::MutexLock lock(&mutex_);
+  records_.push_back(std::move(record));
+  --unfinished_;
+}
+
+void Driver::Report(Clock::duration total) {
+  absl::MutexLock lock(&mutex_);
+  std::vector<const TaskRecord*> sorted;
+  for (const TaskRecord& record : records_) sorted.push_back(&record);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const TaskRecord* a, const TaskRecord* b) {
+              return a->start < b->start;
+            });
+  absl::PrintF("%-6s %-6s %10s %10s  %s\n", "day", "task", "start_ms",
+               "wall_ms", "answer");
+  for (const TaskRecord* record : sorted) {
+    // Multi-line answers (day 8's picture) start on a line of their own.
+    absl::string_view answer = record->answer;
+    absl::PrintF("%-6s %-6s %10.3f %10.3f  %s%s\n", record->day, record->task,
+                 Milliseconds(record->start), Milliseconds(record->wall),
+                 answer.find('\n') != answer.npos ? "\n" : "", answer);
+  }
+  absl::PrintF("Total wall time: %.3f ms on %d threads\n", Milliseconds(total),
+               pool_.size());
+}
@@ -0,0 +1,97 @@
+#ifndef ALL_DRIVER_H_
+#define ALL_DRIVER_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "common/input.h"
+#include "common/solution.h"
+#include "common/thread_pool.h"
+
+// Runs many days' solutions as tasks on one thread pool. Each day's parse is
+// a task; when it finishes, part 1 and part 2 are scheduled as two more tasks
+// sharing the parsed input, so they run at the same time.
+class Driver {
+ public:
+  // Runs on |threads| workers, or one per core if |threads| is zero.
+  explicit Driver(int threads);
+
+  // Adds |solution|, to be run on the input file at |path|.
+  template <typename Input>
+  void Add(const Solution<Input>& solution, const std::string& path);
+
+  // Runs every added day, waits for them all and prints each task's time and
+  // answer, then the total wall time.
+  void Run();
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  // A day's input file and what was parsed from it, which may hold views
+  // into the file.
+  template <typename Input>
+  struct Parsed {
+    Parsed(const std::string& path,
+           const std::function<Input(absl::string_view)>& parse)
+        : file(path), input(parse(file.contents())) {}
+
+    MappedFile file;
+    Input input;
+  };
+
+  // One finished task.
+  struct TaskRecord {
+    std::string day;
+    std::string task;
+    // Relative to the start of Run().
+    Clock::duration start;
+    Clock::duration wall;
+    // Empty for parse tasks.
+    std::string answer;
+  };
+
+  // Runs |fn| on the pool as |task| of |day|, recording its time and the
+  // answer it returns.
+  void RunTask(const std::string& day, const std::string& task,
+               const std::function<std::string()>& fn);
+  void Report(Clock::duration total);
+
+  ThreadPool pool_;
+  // Each added day's parse task, which schedules its parts when done.
+  std::vector<std::function<void()>> parse_tasks_;
+  Clock::time_point run_start_;
+
+  absl::Mutex mutex_;
+  std::vector<TaskRecord> records_ ABSL_GUARDED_BY(mutex_);
+  // Tasks scheduled or still to be scheduled that haven't finished.
+  int64_t unfinished_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+template <typename Input>
+void Driver::Add(const Solution<Input>& solution, const std::string& path) {
+  {
+    absl::MutexLock lock(&mutex_);
+    unfinished_ += 3;
+  }
+  parse_tasks_.push_back([this, solution, path] {
+    std::shared_ptr<const Parsed<Input>> parsed;
+    RunTask(solution.name, "parse", [&] {
+      parsed = std::make_shared<Parsed<Input>>(path, solution.parse);
+      return std::string();
+    });
+    auto schedule_part = [&](const char* task,
+                             std::string (*part)(const Input&)) {
+      pool_.Schedule([this, name = solution.name, task, part, parsed] {
+        RunTask(name, task, [&] { return part(parsed->input); });
+      });
+    };
+    schedule_part("part1", solution.part1);
+    schedule_part("part2", solution.part2);
+  });
+}
+
+#endif  // ALL_DRIVER_H_
@@ -0,0 +1,67 @@
+// Runs every day's solution in one process, with each day's parse, part 1 and
+// part 2 as tasks on a shared thread pool, and prints how long each took.
+// Under bazel run, input files are found relative to the workspace root.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "all/driver.h"
+#include "day1/solution.h"
+#include "day10/solution.h"
+#include "day2/solution.h"
+#include "day3/solution.h"
+#include "day4/solution.h"
+#include "day5/solution.h"
+#include "day6/solution.h"
+#include "day7/solution.h"
+#include "day8/solution.h"
+#include "day9/solution.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+DEFINE_int32(threads, 0, "Worker threads, or one per core if zero.");
+DEFINE_int32(day8_width, 25, "Width of each day 8 image layer, in pixels.");
+DEFINE_int32(day8_height, 6, "Height of each day 8 image layer, in pixels.");
+DEFINE_string(days, "",
+              "Comma-separated days to run, such as \"day1,day9\"; every day "
+              "if empty.");
+
+namespace {
+
+// Adds |solution| to |driver|, reading dayN/input.txt, if --days selects it.
+template <typename Input>
+void MaybeAdd(const Solution<Input>& solution, Driver* driver) {
+  if (!FLAGS_days.empty()) {
+    std::vector<absl::string_view> days =
+        absl::StrSplit(FLAGS_days, ',', absl::SkipEmpty());
+    if (std::find(days.begin(), days.end(), solution.name) == days.end()) {
+      return;
+    }
+  }
+  driver->Add(solution, std::string(solution.name) + "/input.txt");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = 1;
+
+  Driver driver(FLAGS_threads);
+  MaybeAdd(day1::kSolution, &driver);
+  MaybeAdd(day2::kSolution, &driver);
+  MaybeAdd(day3::kSolution, &driver);
+  MaybeAdd(day4::kSolution, &driver);
+  MaybeAdd(day5::kSolution, &driver);
+  MaybeAdd(day6::kSolution, &driver);
+  MaybeAdd(day7::kSolution, &driver);
+  MaybeAdd(day8::MakeSolution(FLAGS_day8_width, FLAGS_day8_height), &driver);
+  MaybeAdd(day9::kSolution, &driver);
+  MaybeAdd(day10::kSolution, &driver);
+  driver.Run();
+  return 0;
+}
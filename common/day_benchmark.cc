@@ -0,0 +1,10 @@
+#include "common/day_benchmark.h"
+
+#include <fstream>
+#include <iterator>
+
+std::string ReadInputFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return "";
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
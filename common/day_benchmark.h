@@ -0,0 +1,123 @@
+#ifndef COMMON_DAY_BENCHMARK_H_
+#define COMMON_DAY_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "common/solution.h"
+
+// Reads the file at |path|, relative to the workspace root (the working
+// directory under bazel run). Returns an empty string if it can't be read.
+std::string ReadInputFile(const std::string& path);
+
+// Makes an input of the given size for the scaled benchmarks; what the size
+// counts (lines, bodies, layers, ...) is up to the day.
+typedef std::function<std::string(int64_t size)> InputGenerator;
+
+namespace day_benchmark_internal {
+
+// Input text made on first use, so generating a large input is only paid
+// for by the benchmarks that aren't filtered out.
+class LazyText {
+ public:
+  explicit LazyText(std::function<std::string()> make)
+      : make_(std::move(make)) {}
+
+  const std::string& Get() {
+    if (make_) {
+      text_ = make_();
+      make_ = nullptr;
+    }
+    return text_;
+  }
+
+ private:
+  std::function<std::string()> make_;
+  std::string text_;
+};
+
+template <typename Input>
+void Register(const Solution<Input>& solution, const std::string& label,
+              std::shared_ptr<LazyText> text) {
+  std::string prefix = absl::StrCat(solution.name, "/");
+  benchmark::RegisterBenchmark(
+      absl::StrCat(prefix, "parse/", label).c_str(),
+      [solution, text](benchmark::State& state) {
+        const std::string& input = text->Get();
+        if (input.empty()) {
+          state.SkipWithError("No input.");
+          return;
+        }
+        for (auto _ : state) {
+          Input parsed = solution.parse(input);
+          benchmark::DoNotOptimize(parsed);
+        }
+        state.SetBytesProcessed(state.iterations() * input.size());
+      })
+      ->Unit(benchmark::kMicrosecond);
+  for (int part : {1, 2}) {
+    auto solve = part == 1 ? solution.part1 : solution.part2;
+    benchmark::RegisterBenchmark(
+        absl::StrCat(prefix, "part", part, "/", label).c_str(),
+        [solution, solve, text](benchmark::State& state) {
+          const std::string& input = text->Get();
+          if (input.empty()) {
+            state.SkipWithError("No input.");
+            return;
+          }
+          Input parsed = solution.parse(input);
+          for (auto _ : state) {
+            std::string answer = solve(parsed);
+            benchmark::DoNotOptimize(answer);
+          }
+        })
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+}  // namespace day_benchmark_internal
+
+// Registers "<day>/parse/<input>", "<day>/part1/<input>" and
+// "<day>/part2/<input>" benchmarks, where the input is "real" for the file at
+// |path| and, if |generate| is set, each of |sizes| for generated inputs.
+// Returns true so it can initialize a namespace-scope variable in a
+// benchmark.cc linked with benchmark_main.
+template <typename Input>
+bool RegisterSolutionBenchmarks(const Solution<Input>& solution,
+                                const std::string& path,
+                                InputGenerator generate,
+                                const std::vector<int64_t>& sizes) {
+  using day_benchmark_internal::LazyText;
+  day_benchmark_internal::Register(
+      solution, "real",
+      std::make_shared<LazyText>([path] { return ReadInputFile(path); }));
+  if (generate) {
+    for (int64_t size : sizes) {
+      day_benchmark_internal::Register(
+          solution, absl::StrCat(size),
+          std::make_shared<LazyText>(
+              [generate, size] { return generate(size); }));
+    }
+  }
+  return true;
+}
+
+// Registers the same benchmarks for one generated input labelled |label|,
+// for days that need a differently set up |solution| for each input, such as
+// day 8's image size.
+template <typename Input>
+bool RegisterGeneratedBenchmarks(const Solution<Input>& solution,
+                                 const std::string& label,
+                                 std::function<std::string()> generate) {
+  day_benchmark_internal::Register(
+      solution, label,
+      std::make_shared<day_benchmark_internal::LazyText>(std::move(generate)));
+  return true;
+}
+
+#endif  // COMMON_DAY_BENCHMARK_H_
@@ -0,0 +1,211 @@
+#include "common/input.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define COMMON_HAVE_SIMD_SCAN 1
+#endif
+
+#include <cstring>
+
+#include "absl/strings/numbers.h"
+#include "glog/logging.h"
+
+namespace {
+
+#ifdef COMMON_HAVE_SIMD_SCAN
+
+// Calls |at(i)| for every i in a prefix of whole vectors of |data| where
+// data[i] is |a| or |b|, in order, and returns the prefix's length.
+template <typename Fn>
+__attribute__((target("avx2"))) size_t ScanDelimitersAvx2(const char* data,
+                                                          size_t size, char a,
+                                                          char b, Fn& at) {
+  const __m256i first = _mm256_set1_epi8(a);
+  const __m256i second = _mm256_set1_epi8(b);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_or_si256(
+        _mm256_cmpeq_epi8(v, first), _mm256_cmpeq_epi8(v, second)));
+    for (; mask != 0; mask &= mask - 1) at(i + __builtin_ctz(mask));
+  }
+  return i;
+}
+
+// As ScanDelimitersAvx2, 16 bytes at a time. SSE2 is part of x86-64, so this
+// needs no check.
+template <typename Fn>
+size_t ScanDelimitersSse2(const char* data, size_t size, char a, char b,
+                          Fn& at) {
+  const __m128i first = _mm_set1_epi8(a);
+  const __m128i second = _mm_set1_epi8(b);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(v, first), _mm_cmpeq_epi8(v, second)));
+    for (; mask != 0; mask &= mask - 1) at(i + __builtin_ctz(mask));
+  }
+  return i;
+}
+
+bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+#endif
+
+ScanWidth& CurrentScanWidth() {
+#ifdef COMMON_HAVE_SIMD_SCAN
+  static ScanWidth width = HasAvx2() ? kScanAvx2 : kScanSse2;
+#else
+  static ScanWidth width = kScanScalar;
+#endif
+  return width;
+}
+
+// Calls |fn(field)| for every non-empty piece of |text| between occurrences
+// of |a| or |b| (which may be the same character).
+template <typename Fn>
+void ForEachField(absl::string_view text, char a, char b, Fn fn) {
+  const char* data = text.data();
+  size_t size = text.size();
+  size_t start = 0;
+  auto delimiter_at = [&](size_t i) {
+    if (i > start) fn(absl::string_view(data + start, i - start));
+    start = i + 1;
+  };
+  size_t i = 0;
+#ifdef COMMON_HAVE_SIMD_SCAN
+  switch (CurrentScanWidth()) {
+    case kScanAvx2:
+      i = ScanDelimitersAvx2(data, size, a, b, delimiter_at);
+      break;
+    case kScanSse2:
+      i = ScanDelimitersSse2(data, size, a, b, delimiter_at);
+      break;
+    case kScanScalar:
+      break;
+  }
+#endif
+  for (; i < size; ++i) {
+    if (data[i] == a || data[i] == b) delimiter_at(i);
+  }
+  if (size > start) fn(absl::string_view(data + start, size - start));
+}
+
+// Converts eight ASCII digits, most significant first, to their value; or
+// returns -1 if any of them isn't a digit.
+int64_t ParseEightDigits(const char* digits) {
+  uint64_t chunk;
+  memcpy(&chunk, digits, sizeof(chunk));
+  // Every byte must be 0x30-0x39: the high nibble is 3, and adding 6 doesn't
+  // carry into it.
+  if (((chunk & 0xF0F0F0F0F0F0F0F0) |
+       (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) !=
+      0x3333333333333333) {
+    return -1;
+  }
+  // Combine neighbouring digits, then pairs, then quads; the first character
+  // is the lowest byte.
+  chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * (10 * 256 + 1)) >> 8;
+  chunk = ((chunk & 0x00FF00FF00FF00FF) * (100 * 65536 + 1)) >> 16;
+  chunk = ((chunk & 0x0000FFFF0000FFFF) * (10000 * (uint64_t{1} << 32) + 1)) >>
+          32;
+  return chunk;
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  PCHECK(fd != -1) << "Can't open " << path;
+  struct stat info;
+  PCHECK(fstat(fd, &info) == 0);
+  size_ = info.st_size;
+  // mmap doesn't allow empty mappings, so leave empty files unmapped.
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    PCHECK(data != MAP_FAILED) << "Can't map " << path;
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+}
+
+std::vector<absl::string_view> Split(absl::string_view text, char delimiter) {
+  std::vector<absl::string_view> pieces;
+  ForEachField(text, delimiter, delimiter,
+               [&](absl::string_view piece) { pieces.push_back(piece); });
+  return pieces;
+}
+
+std::vector<absl::string_view> SplitFields(absl::string_view text) {
+  std::vector<absl::string_view> fields;
+  ForEachField(text, ',', '\n',
+               [&](absl::string_view field) { fields.push_back(field); });
+  return fields;
+}
+
+bool SetScanWidthForTesting(ScanWidth width) {
+#ifdef COMMON_HAVE_SIMD_SCAN
+  if (width == kScanAvx2 && !HasAvx2()) return false;
+#else
+  if (width != kScanScalar) return false;
+#endif
+  CurrentScanWidth() = width;
+  return true;
+}
+
+bool ParseInt(absl::string_view text, int64_t* value) {
+  bool negative = !text.empty() && text[0] == '-';
+  bool sign = negative || (!text.empty() && text[0] == '+');
+  const char* digits = text.data() + sign;
+  size_t count = text.size() - sign;
+  if (count == 0) return false;
+  // Up to 18 digits can't overflow; leave anything longer to absl, once the
+  // digits are checked, since absl would also skip whitespace around them.
+  if (count > 18) {
+    for (size_t i = 0; i < count; ++i) {
+      if (digits[i] < '0' || digits[i] > '9') return false;
+    }
+    return absl::SimpleAtoi(text, value);
+  }
+
+  uint64_t result = 0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    int64_t chunk = ParseEightDigits(digits + i);
+    if (chunk < 0) return false;
+    result = result * 100000000 + chunk;
+  }
+  unsigned invalid = 0;
+  for (; i < count; ++i) {
+    unsigned digit = static_cast<unsigned char>(digits[i]) - '0';
+    invalid |= digit > 9;
+    result = result * 10 + digit;
+  }
+  if (invalid) return false;
+  *value = negative ? -static_cast<int64_t>(result) : result;
+  return true;
+}
+
+std::vector<int64_t> ParseInts(absl::string_view text) {
+  std::vector<int64_t> values;
+  ForEachField(text, ',', '\n', [&](absl::string_view field) {
+    int64_t value;
+    CHECK(ParseInt(field, &value)) << "Not a number: " << field;
+    values.push_back(value);
+  });
+  return values;
+}
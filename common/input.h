@@ -0,0 +1,58 @@
+#ifndef COMMON_INPUT_H_
+#define COMMON_INPUT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+// A whole file mapped read-only into memory. Views into contents() stay valid
+// for as long as the MappedFile does.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  absl::string_view contents() const { return {data_, size_}; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// The non-empty pieces of |text| between occurrences of |delimiter|, as views
+// into |text|. Delimiters are found a vector register at a time.
+std::vector<absl::string_view> Split(absl::string_view text, char delimiter);
+
+// The non-empty lines of |text|.
+inline std::vector<absl::string_view> SplitLines(absl::string_view text) {
+  return Split(text, '\n');
+}
+
+// The non-empty fields of |text| separated by commas or newlines.
+std::vector<absl::string_view> SplitFields(absl::string_view text);
+
+// How many bytes at a time the functions above (and ParseInts) look for
+// delimiters. The default is the widest the CPU supports.
+enum ScanWidth { kScanScalar, kScanSse2, kScanAvx2 };
+
+// Makes every later split scan |width| bytes at a time, so tests can cover
+// each. Returns false, and changes nothing, if the CPU can't.
+bool SetScanWidthForTesting(ScanWidth width);
+
+// Parses a decimal integer with an optional sign into |value|. Digits are
+// validated and accumulated without a branch per character, eight at a time
+// where there are that many. Returns false if |text| isn't exactly a number
+// that fits in an int64.
+bool ParseInt(absl::string_view text, int64_t* value);
+
+// Parses every comma- or newline-separated integer in |text|, in order, such
+// as an intcode program or a list of one number per line. CHECK-fails on a
+// field that isn't a number.
+std::vector<int64_t> ParseInts(absl::string_view text);
+
+#endif  // COMMON_INPUT_H_
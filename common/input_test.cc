@@ -0,0 +1,207 @@
+#include "common/input.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Bytes that aren't digits, including the neighbours of '0' and '9' and bytes
+// whose low nibble is a digit's.
+constexpr char kNonDigits[] = {'/',    ':',    ' ',    '\0',   '-',
+                               '+',    'a',    '\x13', '\x73', '\xB5',
+                               '\xF9', '\x80', '\xFF', '\n',   ','};
+
+// absl::SimpleAtoi, except that it also skips whitespace around the number,
+// which ParseInt doesn't.
+bool ReferenceParseInt(absl::string_view text, int64_t* value) {
+  if (std::any_of(text.begin(), text.end(), absl::ascii_isspace)) return false;
+  return absl::SimpleAtoi(text, value);
+}
+
+void ExpectSameAsAbsl(const std::string& text) {
+  int64_t expected = 0;
+  int64_t value = 0;
+  bool parsed = ReferenceParseInt(text, &expected);
+  ASSERT_EQ(ParseInt(text, &value), parsed)
+      << '"' << absl::CEscape(text) << '"';
+  if (parsed) {
+    EXPECT_EQ(value, expected) << text;
+  }
+}
+
+// A random string of |count| digits.
+std::string RandomDigits(int count, std::mt19937& rng) {
+  std::string digits;
+  for (int i = 0; i < count; ++i) digits += '0' + rng() % 10;
+  return digits;
+}
+
+TEST(ParseIntTest, MatchesAbslForEveryLength) {
+  std::mt19937 rng(1);
+  for (int count = 1; count <= 19; ++count) {
+    for (int trial = 0; trial < 200; ++trial) {
+      std::string digits = RandomDigits(count, rng);
+      // Half without leading zeros, so the long ones really are that big.
+      if (trial % 2 == 0 && digits[0] == '0') digits[0] = '1' + rng() % 9;
+      for (const char* sign : {"", "-", "+"}) {
+        ExpectSameAsAbsl(sign + digits);
+      }
+    }
+  }
+}
+
+TEST(ParseIntTest, RejectsANonDigitAnywhere) {
+  std::mt19937 rng(2);
+  for (int count = 1; count <= 20; ++count) {
+    std::string digits = RandomDigits(count, rng);
+    // Every position, so every byte of each group of eight is covered.
+    for (int position = 0; position < count; ++position) {
+      for (char non_digit : kNonDigits) {
+        std::string text = digits;
+        text[position] = non_digit;
+        for (const char* sign : {"", "-"}) {
+          ExpectSameAsAbsl(sign + text);
+          // A sign in front of the digits is the one exception.
+          if (position == 0 && *sign == '\0' &&
+              (non_digit == '-' || non_digit == '+')) {
+            continue;
+          }
+          int64_t value;
+          EXPECT_FALSE(ParseInt(sign + text, &value))
+              << '"' << absl::CEscape(sign + text) << '"';
+        }
+      }
+    }
+  }
+}
+
+TEST(ParseIntTest, RejectsWhatDoesntFitInAnInt64) {
+  for (const char* text :
+       {"9223372036854775807", "-9223372036854775807", "-9223372036854775808",
+        "9223372036854775808", "-9223372036854775809", "9999999999999999999",
+        "-9999999999999999999", "10000000000000000000", "999999999999999999",
+        "-999999999999999999", "000000000000000000000000000000000000042",
+        "+9223372036854775807", "+9223372036854775808"}) {
+    ExpectSameAsAbsl(text);
+  }
+  int64_t value;
+  EXPECT_TRUE(ParseInt("-9223372036854775808", &value));
+  EXPECT_EQ(value, INT64_MIN);
+  EXPECT_FALSE(ParseInt("9223372036854775808", &value));
+}
+
+TEST(ParseIntTest, RejectsSignsAndSpacesAlone) {
+  for (const char* text : {"", "-", "+", "--1", "+-1", "-+1", " 1", "1 ", " ",
+                           " 1234567890123456789", "1234567890123456789\n"}) {
+    int64_t value;
+    EXPECT_FALSE(ParseInt(text, &value)) << '"' << absl::CEscape(text) << '"';
+  }
+}
+
+TEST(ParseIntTest, MatchesAbslOnRandomStrings) {
+  std::mt19937 rng(3);
+  constexpr absl::string_view kAlphabet = "0123456789012345678901234-+ /:a";
+  for (int trial = 0; trial < 200000; ++trial) {
+    std::string text;
+    for (int length = rng() % 24; length > 0; --length) {
+      text += kAlphabet[rng() % kAlphabet.size()];
+    }
+    ExpectSameAsAbsl(text);
+  }
+}
+
+// Runs |test| once for each scan width this CPU has.
+template <typename Fn>
+void ForEachScanWidth(Fn test) {
+  for (ScanWidth width : {kScanScalar, kScanSse2, kScanAvx2}) {
+    if (!SetScanWidthForTesting(width)) continue;
+    SCOPED_TRACE(testing::Message() << "Scan width " << width);
+    test();
+  }
+}
+
+// Expects the same pieces, as views at the same place in the text.
+void ExpectSamePieces(const std::vector<absl::string_view>& pieces,
+                      const std::vector<absl::string_view>& expected) {
+  ASSERT_EQ(pieces.size(), expected.size());
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    EXPECT_EQ(pieces[i].data(), expected[i].data()) << "Piece " << i;
+    EXPECT_EQ(pieces[i].size(), expected[i].size()) << "Piece " << i;
+  }
+}
+
+void ExpectSplitsLikeAbsl(absl::string_view text) {
+  SCOPED_TRACE(testing::Message() << '"' << absl::CEscape(text) << '"');
+  ExpectSamePieces(Split(text, ','),
+                   absl::StrSplit(text, ',', absl::SkipEmpty()));
+  ExpectSamePieces(SplitLines(text),
+                   absl::StrSplit(text, '\n', absl::SkipEmpty()));
+  ExpectSamePieces(SplitFields(text),
+                   absl::StrSplit(text, absl::ByAnyChar(",\n"),
+                                  absl::SkipEmpty()));
+}
+
+TEST(SplitTest, MatchesAbslAcrossVectorBoundaries) {
+  ForEachScanWidth([] {
+    // One or two delimiters at every pair of places in a string long enough
+    // for two 32-byte vectors and a tail, so fields start, end and cross
+    // every 16- and 32-byte boundary.
+    for (int first = 0; first < 70; ++first) {
+      for (int second = first; second < 70; ++second) {
+        std::string text(70, 'x');
+        text[first] = ',';
+        text[second] = '\n';
+        ExpectSplitsLikeAbsl(text);
+      }
+    }
+  });
+}
+
+TEST(SplitTest, MatchesAbslOnRandomText) {
+  std::mt19937 rng(4);
+  // Room to start the text at any alignment.
+  std::string buffer(32 + 200, ' ');
+  ForEachScanWidth([&] {
+    for (int trial = 0; trial < 5000; ++trial) {
+      int offset = rng() % 32;
+      int length = rng() % 200;
+      // Mostly field characters, with runs of delimiters now and then.
+      for (int i = 0; i < length; ++i) {
+        int pick = rng() % 16;
+        buffer[offset + i] = pick == 0 ? ',' : pick == 1 ? '\n' : 'a' + pick;
+      }
+      ExpectSplitsLikeAbsl(absl::string_view(buffer).substr(offset, length));
+    }
+  });
+}
+
+TEST(ParseIntsTest, MatchesAbsl) {
+  std::mt19937 rng(5);
+  ForEachScanWidth([&] {
+    for (int trial = 0; trial < 500; ++trial) {
+      std::string text;
+      std::vector<int64_t> expected;
+      for (int count = rng() % 40; count > 0; --count) {
+        int64_t value = static_cast<int64_t>(rng()) << 32 | rng();
+        value >>= rng() % 64;
+        if (rng() % 2) value = -value;
+        absl::StrAppend(&text, value, rng() % 4 ? "," : "\n");
+        expected.push_back(value);
+      }
+      EXPECT_EQ(ParseInts(text), expected) << text;
+    }
+  });
+}
+
+}  // namespace
@@ -0,0 +1,181 @@
+#include "common/perf.h"
+
+#include <errno.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "absl/base/attributes.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+DEFINE_string(perf_json, "",
+              "If set, append per-phase wall time, allocation and peak RSS "
+              "measurements to this file as JSON lines.");
+DEFINE_string(perf_label, "",
+              "Free-form label for --perf_json records, such as the input or "
+              "build being measured.");
+
+namespace {
+
+std::atomic<int64_t> allocation_count{0};
+std::atomic<int64_t> allocation_bytes{0};
+
+// What plain operator new must align to, and malloc already does.
+constexpr size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+// Every operator new and delete below goes through this one pair, so each
+// allocation is counted once and freed by the function that matches how it
+// was made. They are kept out of line so that GCC, which would otherwise
+// inline the replaced operators and see free() applied to the result of
+// operator new, doesn't warn about mismatched allocation functions.
+ABSL_ATTRIBUTE_NOINLINE void* CountedAlloc(size_t size, size_t alignment) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  // malloc(0) may return null; operator new must not.
+  if (size == 0) size = 1;
+  if (alignment <= kDefaultAlignment) return malloc(size);
+  // aligned_alloc wants a size that is a multiple of the alignment.
+  size = (size + alignment - 1) / alignment * alignment;
+  return aligned_alloc(alignment, size);
+}
+
+ABSL_ATTRIBUTE_NOINLINE void CountedFree(void* p) { free(p); }
+
+void* CountedNew(size_t size, size_t alignment) {
+  void* p = CountedAlloc(size, alignment);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+const auto process_start = std::chrono::steady_clock::now();
+
+absl::Mutex report_mutex;
+
+std::string JsonString(absl::string_view text) {
+  std::string quoted = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') quoted += '\\';
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+// Appends one record for |phase| to --perf_json, if it is set.
+void Report(absl::string_view phase, std::chrono::nanoseconds wall,
+            AllocationStats allocations) {
+  if (FLAGS_perf_json.empty()) return;
+  std::string line = absl::StrFormat(
+      "{\"binary\":%s,\"label\":%s,\"phase\":%s,\"wall_ns\":%d,"
+      "\"allocs\":%d,\"alloc_bytes\":%d,\"peak_rss_kb\":%d}\n",
+      JsonString(program_invocation_short_name), JsonString(FLAGS_perf_label),
+      JsonString(phase), wall.count(), allocations.count, allocations.bytes,
+      PeakRssKb());
+  absl::MutexLock lock(&report_mutex);
+  FILE* file = fopen(FLAGS_perf_json.c_str(), "a");
+  PCHECK(file != nullptr) << "Can't open " << FLAGS_perf_json;
+  fputs(line.c_str(), file);
+  fclose(file);
+}
+
+// The whole process, reported on exit.
+void ReportTotal() {
+  Report("total", std::chrono::steady_clock::now() - process_start,
+         AllocationsSoFar());
+}
+
+// Registered after the flags above are constructed, so it runs before they
+// are destroyed.
+[[maybe_unused]] const bool total_registered = std::atexit(ReportTotal) == 0;
+
+}  // namespace
+
+void* operator new(size_t size) { return CountedNew(size, kDefaultAlignment); }
+void* operator new[](size_t size) {
+  return CountedNew(size, kDefaultAlignment);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return CountedAlloc(size, kDefaultAlignment);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return CountedAlloc(size, kDefaultAlignment);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CountedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CountedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* p) noexcept { CountedFree(p); }
+void operator delete[](void* p) noexcept { CountedFree(p); }
+void operator delete(void* p, size_t) noexcept { CountedFree(p); }
+void operator delete[](void* p, size_t) noexcept { CountedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  CountedFree(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  CountedFree(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept { CountedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { CountedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  CountedFree(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+  CountedFree(p);
+}
+void operator delete(void* p, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  CountedFree(p);
+}
+void operator delete[](void* p, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  CountedFree(p);
+}
+
+AllocationStats AllocationsSoFar() {
+  AllocationStats stats;
+  stats.count = allocation_count.load(std::memory_order_relaxed);
+  stats.bytes = allocation_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+int64_t PeakRssKb() {
+  struct rusage usage;
+  PCHECK(getrusage(RUSAGE_SELF, &usage) == 0);
+  // Linux reports ru_maxrss in KiB.
+  return usage.ru_maxrss;
+}
+
+ScopedPhase::ScopedPhase(absl::string_view name)
+    : name_(name),
+      start_(std::chrono::steady_clock::now()),
+      start_allocations_(AllocationsSoFar()) {}
+
+ScopedPhase::~ScopedPhase() {
+  auto wall = std::chrono::steady_clock::now() - start_;
+  AllocationStats end = AllocationsSoFar();
+  AllocationStats allocations;
+  allocations.count = end.count - start_allocations_.count;
+  allocations.bytes = end.bytes - start_allocations_.bytes;
+  Report(name_, wall, allocations);
+  VLOG(1) << name_ << ": "
+          << std::chrono::duration_cast<std::chrono::microseconds>(wall)
+                 .count()
+          << "us, " << allocations.count << " allocations, "
+          << allocations.bytes << " bytes";
+}
@@ -0,0 +1,46 @@
+#ifndef COMMON_PERF_H_
+#define COMMON_PERF_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+// Lightweight instrumentation for the day binaries. Linking //common:perf
+// replaces the global operator new so every allocation is counted; timing and
+// reporting only happen for the phases a binary marks with ScopedPhase.
+//
+// When --perf_json is set, each finished phase and a final summary for the
+// process are appended to that file as one JSON object per line, e.g.
+//   {"binary":"day6","label":"","phase":"part1","wall_ns":51234,
+//    "allocs":3,"alloc_bytes":4096,"peak_rss_kb":10240}
+
+// Allocations made through operator new since the process started.
+struct AllocationStats {
+  int64_t count = 0;
+  int64_t bytes = 0;
+};
+AllocationStats AllocationsSoFar();
+
+// Peak resident set size of the process so far, in KiB.
+int64_t PeakRssKb();
+
+// Measures the wall time and allocations between construction and
+// destruction and reports them under |name| (such as "parse", "part1" or
+// "part2").
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(absl::string_view name);
+  ~ScopedPhase();
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  std::string name_;
+  std::chrono::steady_clock::time_point start_;
+  AllocationStats start_allocations_;
+};
+
+#endif  // COMMON_PERF_H_
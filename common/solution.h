@@ -0,0 +1,29 @@
+#ifndef COMMON_SOLUTION_H_
+#define COMMON_SOLUTION_H_
+
+#include <functional>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+// One day's puzzle: parse the input text once, then answer each part from the
+// parsed input. Each part is independent of the other, so they can be timed
+// or run separately.
+//
+// Every day declares its Parse, Part1 and Part2 in its own namespace in
+// dayN/solution.h, along with a kSolution bundling them for the binaries that
+// handle every day the same way (benchmarks, drivers). A day whose input
+// doesn't say everything needed to parse it offers a function making its
+// Solution instead, like day 8's MakeSolution(width, height).
+template <typename Input>
+struct Solution {
+  // The day, e.g. "day1".
+  const char* name;
+  // |text| must outlive the result, which may hold views into it. Not a plain
+  // function pointer, so it can carry settings such as day 8's image size.
+  std::function<Input(absl::string_view text)> parse;
+  std::string (*part1)(const Input& input);
+  std::string (*part2)(const Input& input);
+};
+
+#endif  // COMMON_SOLUTION_H_
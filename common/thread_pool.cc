@@ -0,0 +1,139 @@
+#include "common/thread_pool.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+
+namespace {
+
+// The pool and index of the worker running on this thread, or null and -1
+// off any pool.
+thread_local ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+// Progress through one ParallelFor. Shared with the scheduled helpers, since
+// one may only start after the loop has finished and returned.
+struct Loop {
+  explicit Loop(int64_t blocks) : blocks_left(blocks) {}
+
+  std::atomic<int64_t> next{0};
+  absl::Mutex mutex;
+  int64_t blocks_left ABSL_GUARDED_BY(mutex);
+};
+
+// Runs blocks of |loop| as |worker| until none are left to claim.
+void RunBlocks(Loop* loop, int64_t n, int64_t block_size, int worker,
+               const std::function<void(int, int64_t, int64_t)>& fn) {
+  for (int64_t begin = loop->next.fetch_add(block_size); begin < n;
+       begin = loop->next.fetch_add(block_size)) {
+    fn(worker, begin, std::min(n, begin + block_size));
+    absl::MutexLock lock(&loop->mutex);
+    --loop->blocks_left;
+  }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  CHECK_GT(threads, 0);
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back(&ThreadPool::Work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  for (auto& worker : workers_) worker.join();
+}
+
+ThreadPool* ThreadPool::Current() { return current_pool; }
+
+ThreadPool& ThreadPool::Default() {
+  if (current_pool != nullptr) return *current_pool;
+  // Leaked, so nothing waits at exit for workers of a pool a static
+  // destructor might still be using.
+  static ThreadPool* const shared = new ThreadPool();
+  return *shared;
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  int queue = current_pool == this
+                  ? current_worker
+                  : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                        queues_.size();
+  {
+    absl::MutexLock lock(&queues_[queue]->mutex);
+    queues_[queue]->tasks.push_back(std::move(task));
+  }
+  absl::MutexLock lock(&mutex_);
+  ++pending_;
+}
+
+void ThreadPool::ParallelFor(
+    int64_t n, int64_t block_size,
+    const std::function<void(int worker, int64_t begin, int64_t end)>& fn) {
+  CHECK_GT(block_size, 0);
+  if (n <= 0) return;
+  // Every worker pulls blocks from a shared cursor until they run out, so
+  // uneven blocks balance themselves.
+  int64_t blocks = (n + block_size - 1) / block_size;
+  auto loop = std::make_shared<Loop>(blocks);
+  // A worker of this pool calling in takes part itself: waiting idle would
+  // hold a thread the helpers might need.
+  const bool on_pool = current_pool == this;
+  int helpers = std::min<int64_t>(size() - (on_pool ? 1 : 0),
+                                  blocks - (on_pool ? 1 : 0));
+  for (int i = 0; i < helpers; ++i) {
+    Schedule([loop, n, block_size, &fn] {
+      RunBlocks(loop.get(), n, block_size, current_worker, fn);
+    });
+  }
+  if (on_pool) RunBlocks(loop.get(), n, block_size, current_worker, fn);
+  // Helpers that haven't started by now find no blocks left and never touch
+  // |fn|, so only blocks already claimed are waited for.
+  absl::MutexLock lock(&loop->mutex);
+  loop->mutex.Await(absl::Condition(
+      +[](int64_t* left) { return *left == 0; }, &loop->blocks_left));
+}
+
+std::function<void()> ThreadPool::Take(int worker) {
+  // Each claim leaves a task queued for it, though another worker may take
+  // the one seen here first, so keep going round until one turns up.
+  for (int i = 0;; i = (i + 1) % queues_.size()) {
+    Queue& queue = *queues_[(worker + i) % queues_.size()];
+    absl::MutexLock lock(&queue.mutex);
+    if (queue.tasks.empty()) continue;
+    std::function<void()> task;
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    return task;
+  }
+}
+
+void ThreadPool::Work(int worker) {
+  current_pool = this;
+  current_worker = worker;
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &ThreadPool::HasWorkOrStopping));
+      if (pending_ == 0) return;
+      --pending_;
+    }
+    Take(worker)();
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef COMMON_THREAD_POOL_H_
+#define COMMON_THREAD_POOL_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+
+// A fixed set of worker threads that run scheduled tasks.
+//
+// Each worker has its own queue. Tasks scheduled from a worker go on that
+// worker's queue and are run newest first, so follow-up work stays on the
+// thread whose cache holds its inputs; idle workers steal the oldest tasks
+// from the other queues.
+class ThreadPool {
+ public:
+  // Starts |threads| workers, or one per core if |threads| is zero.
+  explicit ThreadPool(int threads = 0);
+  // Finishes every scheduled task, then stops the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // The pool whose worker is running on this thread, or null off any pool.
+  static ThreadPool* Current();
+  // Current() if on a pool, or else one pool shared by the whole process,
+  // with a worker per core, started on first use and never stopped. Use this
+  // rather than starting a pool per call.
+  static ThreadPool& Default();
+
+  // Number of worker threads.
+  int size() const { return workers_.size(); }
+
+  // Runs |task| on some worker.
+  void Schedule(std::function<void()> task);
+
+  // Calls |fn(worker, begin, end)| over [0, |n|) in blocks of |block_size|,
+  // spread over every worker, and waits for them all. |worker| is in [0,
+  // size()) and no two calls with the same |worker| run at once, so it can
+  // index per-thread scratch space. Called from one of this pool's own tasks,
+  // the calling worker runs blocks too rather than blocking.
+  void ParallelFor(int64_t n, int64_t block_size,
+                   const std::function<void(int worker, int64_t begin,
+                                            int64_t end)>& fn);
+
+ private:
+  struct Queue {
+    absl::Mutex mutex;
+    std::deque<std::function<void()>> tasks ABSL_GUARDED_BY(mutex);
+  };
+
+  void Work(int worker);
+  // Takes a task, preferring the newest on |worker|'s own queue and then the
+  // oldest on any other. Only called once a task has been claimed from
+  // pending_, so one is always there to find.
+  std::function<void()> Take(int worker);
+  bool HasWorkOrStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return stopping_ || pending_ > 0;
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  // Queue for the next task scheduled from off the pool.
+  std::atomic<unsigned> next_queue_{0};
+
+  absl::Mutex mutex_;
+  // Tasks queued and not yet claimed by a worker.
+  int64_t pending_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stopping_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::thread> workers_;
+};
+
+#endif  // COMMON_THREAD_POOL_H_
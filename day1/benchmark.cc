@@ -0,0 +1,13 @@
+#include "common/day_benchmark.h"
+#include "day1/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are numbers of modules.
+const bool registered = RegisterSolutionBenchmarks(
+    day1::kSolution, "day1/input.txt",
+    [](int64_t size) { return GenerateMasses(size, 1000, 200000, size); },
+    {1 << 10, 1 << 16, 1 << 22});
+
+}  // namespace
@@ -0,0 +1,139 @@
+#include "day1/fuel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAY1_HAVE_AVX2_KERNEL 1
+#endif
+
+namespace {
+
+#ifdef DAY1_HAVE_AVX2_KERNEL
+
+// Eight masses as 32-bit lanes, or false if any is outside [0, 2^31).
+__attribute__((target("avx2"))) bool LoadMasses(const int64_t* masses,
+                                                __m256i* lanes) {
+  __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masses));
+  __m256i high =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masses + 4));
+  // Anything at or above bit 31 (including the sign) is out of range.
+  __m256i overflow =
+      _mm256_or_si256(_mm256_srli_epi64(low, 31), _mm256_srli_epi64(high, 31));
+  if (!_mm256_testz_si256(overflow, overflow)) return false;
+  // Gather each half's low 32-bit words into its bottom 128 bits.
+  const __m256i pick = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  *lanes = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(
+          _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(low, pick))),
+      _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(high, pick)), 1);
+  return true;
+}
+
+// Each non-negative 32-bit lane of |x| divided by 3, minus 2. x / 3 is
+// (x * 0xAAAAAAAB) >> 33 for any x < 2^32; AVX2 only multiplies the even
+// lanes into 64 bits, so the odd lanes are shifted down and done separately.
+__attribute__((target("avx2"))) __m256i Fuel(__m256i x) {
+  const __m256i magic = _mm256_set1_epi32(0xAAAAAAAB);
+  __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, magic), 33);
+  __m256i odd = _mm256_srli_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(x, 32), magic), 33);
+  __m256i quotient =
+      _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+  return _mm256_sub_epi32(quotient, _mm256_set1_epi32(2));
+}
+
+// Adds the eight signed 32-bit lanes of |x| to the four 64-bit lanes of
+// |sum|.
+__attribute__((target("avx2"))) __m256i AddWidened(__m256i sum, __m256i x) {
+  sum = _mm256_add_epi64(sum,
+                         _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+  return _mm256_add_epi64(
+      sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+}
+
+__attribute__((target("avx2"))) int64_t HorizontalSum(__m256i sum) {
+  alignas(32) int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Sums over |masses|, eight at a time, with |with_fuel| choosing between part
+// 1 and part 2. Blocks with a mass out of range go to |scalar|.
+template <bool with_fuel>
+__attribute__((target("avx2"))) int64_t SumFuelAvx2(
+    absl::Span<const int64_t> masses,
+    int64_t (*scalar)(absl::Span<const int64_t>)) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum = zero;
+  int64_t scalar_sum = 0;
+  size_t i = 0;
+  for (; i + 8 <= masses.size(); i += 8) {
+    __m256i mass;
+    if (!LoadMasses(masses.data() + i, &mass)) {
+      scalar_sum += scalar(masses.subspan(i, 8));
+      continue;
+    }
+    __m256i fuel = Fuel(mass);
+    if (with_fuel) {
+      // A lane's running total stays within 32 bits: each step adds under a
+      // third of the last, so the total is under half the mass.
+      __m256i total = fuel;
+      __m256i last = fuel;
+      for (;;) {
+        // Lanes that have finished (or started) at zero or below only ever
+        // produce -2 from here, which the mask drops.
+        __m256i next = Fuel(_mm256_max_epi32(last, zero));
+        __m256i active = _mm256_cmpgt_epi32(next, zero);
+        if (_mm256_testz_si256(active, active)) break;
+        total = _mm256_add_epi32(total, _mm256_and_si256(next, active));
+        last = next;
+      }
+      fuel = total;
+    }
+    sum = AddWidened(sum, fuel);
+  }
+  return HorizontalSum(sum) + scalar_sum + scalar(masses.subspan(i));
+}
+
+bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+#endif
+
+}  // namespace
+
+int64_t FuelForFuel(int64_t fuel) {
+  int64_t next_fuel = ModuleFuel(fuel);
+  while (next_fuel > 0) {
+    fuel += next_fuel;
+    next_fuel = ModuleFuel(next_fuel);
+  }
+  return fuel;
+}
+
+int64_t SumModuleFuelScalar(absl::Span<const int64_t> masses) {
+  int64_t fuel = 0;
+  for (int64_t mass : masses) fuel += ModuleFuel(mass);
+  return fuel;
+}
+
+int64_t SumTotalFuelScalar(absl::Span<const int64_t> masses) {
+  int64_t fuel = 0;
+  for (int64_t mass : masses) fuel += FuelForFuel(ModuleFuel(mass));
+  return fuel;
+}
+
+int64_t SumModuleFuel(absl::Span<const int64_t> masses) {
+#ifdef DAY1_HAVE_AVX2_KERNEL
+  if (HasAvx2()) return SumFuelAvx2<false>(masses, SumModuleFuelScalar);
+#endif
+  return SumModuleFuelScalar(masses);
+}
+
+int64_t SumTotalFuel(absl::Span<const int64_t> masses) {
+#ifdef DAY1_HAVE_AVX2_KERNEL
+  if (HasAvx2()) return SumFuelAvx2<true>(masses, SumTotalFuelScalar);
+#endif
+  return SumTotalFuelScalar(masses);
+}
@@ -0,0 +1,31 @@
+#ifndef DAY1_FUEL_H_
+#define DAY1_FUEL_H_
+
+#include <cstdint>
+
+#include "absl/types/span.h"
+
+// Fuel for a module of |mass|: a third of it, rounded down, minus 2.
+inline int64_t ModuleFuel(int64_t mass) { return mass / 3 - 2; }
+
+// Fuel for |fuel| units of fuel, including the fuel itself: keeps adding fuel
+// for the last amount added until that comes to zero or less.
+int64_t FuelForFuel(int64_t fuel);
+
+// Batch totals over |masses|: the sum of ModuleFuel (part 1), or of
+// FuelForFuel(ModuleFuel) (part 2).
+//
+// With AVX2 (checked at run time) masses are handled eight at a time as
+// 32-bit lanes, dividing by 3 with a multiply by a magic constant. Part 2's
+// repeated fuel step runs on all eight lanes at once, masking off lanes as
+// they finish, until none are left. Lane sums are widened to 64 bits before
+// accumulating. Masses outside [0, 2^31) fall back to the scalar code, which
+// gives the same totals.
+int64_t SumModuleFuel(absl::Span<const int64_t> masses);
+int64_t SumTotalFuel(absl::Span<const int64_t> masses);
+
+// The same totals, one mass at a time.
+int64_t SumModuleFuelScalar(absl::Span<const int64_t> masses);
+int64_t SumTotalFuelScalar(absl::Span<const int64_t> masses);
+
+#endif  // DAY1_FUEL_H_
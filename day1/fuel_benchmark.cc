@@ -0,0 +1,38 @@
+// Compares the batch fuel sums with AVX2 (when the CPU has it) against the
+// scalar loops.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "day1/fuel.h"
+#include "gen/generators.h"
+
+namespace {
+
+std::vector<int64_t> Masses(int64_t count) {
+  std::vector<int64_t> masses;
+  SeededRandom random(count);
+  masses.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    masses.push_back(random.Between(1000, 200000));
+  }
+  return masses;
+}
+
+template <int64_t (*sum)(absl::Span<const int64_t>)>
+void BM_Sum(benchmark::State& state) {
+  const std::vector<int64_t> masses = Masses(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sum(masses));
+  }
+  state.SetItemsProcessed(state.iterations() * masses.size());
+  state.SetBytesProcessed(state.iterations() * masses.size() *
+                          sizeof(int64_t));
+}
+
+BENCHMARK_TEMPLATE(BM_Sum, SumModuleFuelScalar)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_Sum, SumModuleFuel)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_Sum, SumTotalFuelScalar)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_Sum, SumTotalFuel)->Range(1 << 10, 1 << 24);
+
+}  // namespace
@@ -0,0 +1,19 @@
+#include "day1/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "common/input.h"
+#include "day1/fuel.h"
+
+namespace day1 {
+
+Input Parse(absl::string_view text) { return ParseInts(text); }
+
+std::string Part1(const Input& masses) {
+  return absl::StrCat(SumModuleFuel(masses));
+}
+
+std::string Part2(const Input& masses) {
+  return absl::StrCat(SumTotalFuel(masses));
+}
+
+}  // namespace day1
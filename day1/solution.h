@@ -0,0 +1,26 @@
+#ifndef DAY1_SOLUTION_H_
+#define DAY1_SOLUTION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+
+namespace day1 {
+
+// Module masses.
+typedef std::vector<int64_t> Input;
+
+Input Parse(absl::string_view text);
+// Fuel for the modules.
+std::string Part1(const Input& masses);
+// Fuel for the modules and for the fuel itself.
+std::string Part2(const Input& masses);
+
+inline const Solution<Input> kSolution = {"day1", Parse, Part1, Part2};
+
+}  // namespace day1
+
+#endif  // DAY1_SOLUTION_H_
@@ -0,0 +1,34 @@
+#include "day10/asteroid_grid.h"
+
+#include <algorithm>
+
+#include "common/input.h"
+#include "glog/logging.h"
+
+AsteroidGrid::AsteroidGrid(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      row_words_((cols + 63) / 64),
+      words_(static_cast<size_t>(rows) * row_words_, 0) {
+  CHECK_GE(rows, 0);
+  CHECK_GE(cols, 0);
+}
+
+AsteroidGrid AsteroidGrid::Parse(absl::string_view text) {
+  std::vector<absl::string_view> lines = SplitLines(text);
+  int cols = 0;
+  for (auto line : lines) cols = std::max<int>(cols, line.size());
+  AsteroidGrid grid(lines.size(), cols);
+  for (int row = 0; row < lines.size(); ++row) {
+    for (int col = 0; col < lines[row].size(); ++col) {
+      if (lines[row][col] == '#') grid.set(row, col);
+    }
+  }
+  return grid;
+}
+
+int64_t AsteroidGrid::count() const {
+  int64_t total = 0;
+  for (uint64_t word : words_) total += __builtin_popcountll(word);
+  return total;
+}
@@ -0,0 +1,64 @@
+#ifndef DAY10_ASTEROID_GRID_H_
+#define DAY10_ASTEROID_GRID_H_
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+// Row, column.
+typedef std::tuple<int, int> PosT;
+
+// The asteroid map with one bit per cell. Rows are stored one after another,
+// each padded to a whole number of 64-bit words, so a probe is one load and a
+// mask and walking every asteroid skips empty space a word at a time.
+class AsteroidGrid {
+ public:
+  AsteroidGrid(int rows, int cols);
+
+  // Parses a map where '#' is an asteroid, one row per line.
+  static AsteroidGrid Parse(absl::string_view text);
+
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+
+  bool test(int row, int col) const {
+    return (Word(row, col) >> (col % 64)) & 1;
+  }
+  bool test(PosT pos) const { return test(std::get<0>(pos), std::get<1>(pos)); }
+  void set(int row, int col) { Word(row, col) |= Bit(col); }
+  void reset(int row, int col) { Word(row, col) &= ~Bit(col); }
+
+  // Number of asteroids.
+  int64_t count() const;
+
+  // Calls |fn(row, col)| for every asteroid, in row-major order.
+  template <typename Fn>
+  void ForEach(Fn fn) const {
+    for (int row = 0; row < rows_; ++row) {
+      const uint64_t* words = &words_[static_cast<size_t>(row) * row_words_];
+      for (int w = 0; w < row_words_; ++w) {
+        for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+          fn(row, w * 64 + __builtin_ctzll(bits));
+        }
+      }
+    }
+  }
+
+ private:
+  static uint64_t Bit(int col) { return uint64_t{1} << (col % 64); }
+  uint64_t& Word(int row, int col) {
+    return words_[static_cast<size_t>(row) * row_words_ + col / 64];
+  }
+  const uint64_t& Word(int row, int col) const {
+    return words_[static_cast<size_t>(row) * row_words_ + col / 64];
+  }
+
+  int rows_;
+  int cols_;
+  int row_words_;
+  std::vector<uint64_t> words_;
+};
+
+#endif  // DAY10_ASTEROID_GRID_H_
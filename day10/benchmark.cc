@@ -0,0 +1,13 @@
+#include "common/day_benchmark.h"
+#include "day10/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are the side of a square map, three tenths asteroids.
+const bool registered = RegisterSolutionBenchmarks(
+    day10::kSolution, "day10/input.txt",
+    [](int64_t size) { return GenerateAsteroidField(size, size, 0.3, size); },
+    {32, 64, 128});
+
+}  // namespace
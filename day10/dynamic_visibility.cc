@@ -0,0 +1,109 @@
+#include "day10/dynamic_visibility.h"
+
+#include <cstdlib>
+#include <numeric>
+
+#include "glog/logging.h"
+
+namespace {
+
+int Steps(int delta_row, int delta_col) {
+  return std::abs(delta_row) + std::abs(delta_col);
+}
+
+}  // namespace
+
+DynamicVisibility::DynamicVisibility(AsteroidGrid grid)
+    : grid_(std::move(grid)),
+      nearest_(static_cast<size_t>(grid_.rows()) * grid_.cols()) {
+  grid_.ForEach([&](int row, int col) {
+    int cell = Cell(row, col);
+    grid_.ForEach([&](int other_row, int other_col) {
+      if (other_row == row && other_col == col) return;
+      Offer(cell, Direction(other_row - row, other_col - col),
+            Cell(other_row, other_col));
+    });
+  });
+}
+
+void DynamicVisibility::Add(PosT pos) {
+  auto [row, col] = pos;
+  CHECK(!grid_.test(pos)) << "Already an asteroid at " << row << "," << col;
+  grid_.set(row, col);
+  int cell = Cell(row, col);
+
+  // Find the new asteroid's own neighbours.
+  nearest_[cell].clear();
+  grid_.ForEach([&](int other_row, int other_col) {
+    if (other_row == row && other_col == col) return;
+    Offer(cell, Direction(other_row - row, other_col - col),
+          Cell(other_row, other_col));
+  });
+  // Each of them now sees the new asteroid in place of whatever was beyond it
+  // (or nothing).
+  for (auto [key, neighbour] : nearest_[cell]) {
+    Offer(neighbour, -key, cell);
+  }
+}
+
+void DynamicVisibility::Remove(PosT pos) {
+  auto [row, col] = pos;
+  CHECK(grid_.test(pos)) << "No asteroid at " << row << "," << col;
+  grid_.reset(row, col);
+  int cell = Cell(row, col);
+
+  // Every neighbour loses sight of this asteroid and instead sees the next
+  // asteroid further along the same ray, if there is one.
+  for (auto [key, neighbour] : nearest_[cell]) {
+    auto [neighbour_row, neighbour_col] = Pos(neighbour);
+    int delta_row = row - neighbour_row;
+    int delta_col = col - neighbour_col;
+    int gcd = std::gcd(delta_row, delta_col);
+    int step_row = delta_row / gcd;
+    int step_col = delta_col / gcd;
+
+    auto& neighbour_nearest = nearest_[neighbour];
+    neighbour_nearest.erase(-key);
+    for (int r = row + step_row, c = col + step_col;
+         r >= 0 && r < grid_.rows() && c >= 0 && c < grid_.cols();
+         r += step_row, c += step_col) {
+      if (grid_.test(r, c)) {
+        neighbour_nearest[-key] = Cell(r, c);
+        break;
+      }
+    }
+  }
+  nearest_[cell].clear();
+}
+
+int DynamicVisibility::Visible(PosT pos) const {
+  CHECK(grid_.test(pos));
+  return nearest_[Cell(std::get<0>(pos), std::get<1>(pos))].size();
+}
+
+Station DynamicVisibility::Best() const {
+  Station best = {{-1, -1}, -1};
+  grid_.ForEach([&](int row, int col) {
+    int visible = nearest_[Cell(row, col)].size();
+    if (visible > best.visible) best = {{row, col}, visible};
+  });
+  CHECK_GE(best.visible, 0) << "No asteroids.";
+  return best;
+}
+
+int DynamicVisibility::Direction(int delta_row, int delta_col) const {
+  int gcd = std::gcd(delta_row, delta_col);
+  return (delta_row / gcd) * (2 * grid_.cols() - 1) + delta_col / gcd;
+}
+
+void DynamicVisibility::Offer(int cell, int key, int other) {
+  auto [iter, inserted] = nearest_[cell].try_emplace(key, other);
+  if (inserted) return;
+  auto [row, col] = Pos(cell);
+  auto [current_row, current_col] = Pos(iter->second);
+  auto [other_row, other_col] = Pos(other);
+  if (Steps(other_row - row, other_col - col) <
+      Steps(current_row - row, current_col - col)) {
+    iter->second = other;
+  }
+}
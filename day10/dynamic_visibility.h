@@ -0,0 +1,55 @@
+#ifndef DAY10_DYNAMIC_VISIBILITY_H_
+#define DAY10_DYNAMIC_VISIBILITY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "day10/asteroid_grid.h"
+#include "day10/visibility.h"
+
+// Visible counts for every asteroid on a map that changes, such as after each
+// vaporization. For every asteroid this keeps its nearest neighbour in each
+// direction that has one; the visible count is the number of directions.
+//
+// Visibility is symmetric, so the asteroids affected by adding or removing
+// one are exactly those it can see. Adding scans the map once for the new
+// asteroid's own neighbours (O(n)); removing walks only the rays through the
+// removed asteroid to find who each neighbour sees next. Neither recomputes
+// anything else.
+class DynamicVisibility {
+ public:
+  explicit DynamicVisibility(AsteroidGrid grid);
+
+  // Adds an asteroid at the empty cell |pos|.
+  void Add(PosT pos);
+  // Removes the asteroid at |pos|.
+  void Remove(PosT pos);
+
+  // Number of other asteroids visible from the asteroid at |pos|.
+  int Visible(PosT pos) const;
+  // The asteroid that can see the most others; ties go to the earliest in
+  // row-major order. O(n).
+  Station Best() const;
+
+  const AsteroidGrid& grid() const { return grid_; }
+
+ private:
+  int Cell(int row, int col) const { return row * grid_.cols() + col; }
+  PosT Pos(int cell) const {
+    return {cell / grid_.cols(), cell % grid_.cols()};
+  }
+  // Key for the reduced direction of (|delta_row|, |delta_col|). The key of
+  // the opposite direction is the negated key.
+  int Direction(int delta_row, int delta_col) const;
+  // Records |other| as |cell|'s neighbour in direction |key| if it is the
+  // first or the nearest seen in that direction.
+  void Offer(int cell, int key, int other);
+
+  AsteroidGrid grid_;
+  // For each cell with an asteroid: reduced direction key -> nearest
+  // asteroid's cell in that direction.
+  std::vector<absl::flat_hash_map<int, int>> nearest_;
+};
+
+#endif  // DAY10_DYNAMIC_VISIBILITY_H_
@@ -0,0 +1,80 @@
+// Compares keeping the best station current under a stream of asteroid
+// additions and removals by recomputing every visible count after each edit
+// against updating DynamicVisibility.
+
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "day10/asteroid_grid.h"
+#include "day10/dynamic_visibility.h"
+#include "day10/visibility.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Random cells to toggle: each edit removes the asteroid there, or adds one
+// if the cell is empty.
+std::vector<PosT> MakeEdits(const AsteroidGrid& grid, int edits) {
+  std::mt19937 rng(edits);
+  std::vector<PosT> cells;
+  for (int i = 0; i < edits; ++i) {
+    cells.push_back({static_cast<int>(rng() % grid.rows()),
+                     static_cast<int>(rng() % grid.cols())});
+  }
+  return cells;
+}
+
+void BM_FullRecompute(benchmark::State& state) {
+  const AsteroidGrid initial = AsteroidGrid::Parse(
+      GenerateAsteroidField(state.range(0), state.range(0), 0.5, 1));
+  const std::vector<PosT> edits = MakeEdits(initial, state.range(1));
+  for (auto _ : state) {
+    AsteroidGrid grid = initial;
+    for (const auto& [row, col] : edits) {
+      if (grid.test(row, col)) {
+        grid.reset(row, col);
+      } else {
+        grid.set(row, col);
+      }
+      benchmark::DoNotOptimize(FindBestStation(grid));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * edits.size());
+}
+
+void BM_Incremental(benchmark::State& state) {
+  const AsteroidGrid initial = AsteroidGrid::Parse(
+      GenerateAsteroidField(state.range(0), state.range(0), 0.5, 1));
+  const std::vector<PosT> edits = MakeEdits(initial, state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    DynamicVisibility visibility(initial);
+    state.ResumeTiming();
+    for (const PosT& pos : edits) {
+      if (visibility.grid().test(pos)) {
+        visibility.Remove(pos);
+      } else {
+        visibility.Add(pos);
+      }
+      benchmark::DoNotOptimize(visibility.Best());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * edits.size());
+}
+
+// Arguments are the side of a square map, half asteroids (sides 23, 46 and
+// 91 give about 2^8, 2^10 and 2^12), and the number of edits.
+BENCHMARK(BM_FullRecompute)
+    ->Args({23, 64})
+    ->Args({46, 64})
+    ->Args({91, 64})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Incremental)
+    ->Args({23, 64})
+    ->Args({46, 64})
+    ->Args({91, 64})
+    ->Args({91, 4096})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
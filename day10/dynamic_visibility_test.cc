@@ -0,0 +1,79 @@
+#include "day10/dynamic_visibility.h"
+
+#include <random>
+
+#include "day10/asteroid_grid.h"
+#include "day10/visibility.h"
+#include "gen/generators.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Expects every asteroid's count, and the best station, to match a scan of
+// the map from scratch.
+void ExpectSameAsRecount(const DynamicVisibility& dynamic) {
+  const AsteroidGrid& grid = dynamic.grid();
+  VisibilityScanner scanner(grid.rows(), grid.cols());
+  grid.ForEach([&](int row, int col) {
+    EXPECT_EQ(dynamic.Visible({row, col}),
+              scanner.CountVisible(grid, {row, col}))
+        << "At " << row << "," << col;
+  });
+  if (grid.count() == 0) return;
+  Station expected = FindBestStation(grid);
+  Station best = dynamic.Best();
+  EXPECT_EQ(best.pos, expected.pos);
+  EXPECT_EQ(best.visible, expected.visible);
+}
+
+TEST(DynamicVisibilityTest, MatchesRecountAfterEveryEdit) {
+  struct Map {
+    int rows;
+    int cols;
+    double density;
+  };
+  // Sparse and dense, square and not, and one wider than a 64-bit word.
+  for (Map map : {Map{1, 9, 0.5}, Map{7, 7, 0.2}, Map{12, 12, 0.5},
+                  Map{9, 16, 0.9}, Map{5, 70, 0.3}}) {
+    for (uint64_t seed : {1, 2, 3}) {
+      SCOPED_TRACE(testing::Message() << map.rows << "x" << map.cols << " at "
+                                      << map.density << ", seed " << seed);
+      DynamicVisibility dynamic(AsteroidGrid::Parse(
+          GenerateAsteroidField(map.rows, map.cols, map.density, seed)));
+      ExpectSameAsRecount(dynamic);
+
+      std::mt19937 rng(seed);
+      std::uniform_int_distribution<int> row(0, map.rows - 1);
+      std::uniform_int_distribution<int> col(0, map.cols - 1);
+      for (int edit = 0; edit < 60; ++edit) {
+        PosT pos = {row(rng), col(rng)};
+        if (dynamic.grid().test(pos)) {
+          dynamic.Remove(pos);
+        } else {
+          dynamic.Add(pos);
+        }
+        ExpectSameAsRecount(dynamic);
+        if (HasFailure()) return;
+      }
+    }
+  }
+}
+
+TEST(DynamicVisibilityTest, EmptiesAndRefillsALine) {
+  // Every asteroid on one ray, removed from the middle outwards and added
+  // back, so each removal hands neighbours on to the next along the ray.
+  AsteroidGrid grid(9, 9);
+  for (int i = 0; i < 9; ++i) grid.set(i, i);
+  DynamicVisibility dynamic(grid);
+  for (int i : {4, 3, 5, 2, 6, 1, 7, 0}) {
+    dynamic.Remove({i, i});
+    ExpectSameAsRecount(dynamic);
+  }
+  for (int i : {0, 8, 4, 2, 6, 1, 3, 5, 7}) {
+    if (dynamic.grid().test(i, i)) continue;
+    dynamic.Add({i, i});
+    ExpectSameAsRecount(dynamic);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,39 @@
+#include "day10/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "common/thread_pool.h"
+#include "day10/vaporize.h"
+#include "day10/visibility.h"
+
+namespace day10 {
+namespace {
+
+// Below this many asteroids the whole search takes about a millisecond, too
+// little to be worth handing out to other threads.
+constexpr int64_t kParallelAsteroids = 1024;
+
+// Large maps run on the pool this is called from, if any, so a driver
+// running many days shares its threads; otherwise on the process's shared
+// pool.
+Station BestStation(const AsteroidGrid& grid) {
+  if (grid.count() < kParallelAsteroids) return FindBestStation(grid);
+  return FindBestStation(grid, ThreadPool::Default());
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) { return AsteroidGrid::Parse(text); }
+
+std::string Part1(const Input& grid) {
+  // Find the most asteroids detected.
+  return absl::StrCat(BestStation(grid).visible);
+}
+
+std::string Part2(const Input& grid) {
+  // Find the 200th asteroid vaporized from the best station.
+  VaporizationOrder order(grid, BestStation(grid).pos);
+  auto [row, col] = order.Vaporized(200);
+  return absl::StrCat(col * 100 + row);
+}
+
+}  // namespace day10
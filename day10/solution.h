@@ -0,0 +1,25 @@
+#ifndef DAY10_SOLUTION_H_
+#define DAY10_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "day10/asteroid_grid.h"
+
+namespace day10 {
+
+// The asteroid map.
+typedef AsteroidGrid Input;
+
+Input Parse(absl::string_view text);
+// The most asteroids visible from any one asteroid, where the station goes.
+std::string Part1(const Input& grid);
+// 100 * x + y for the 200th asteroid the station's laser vaporizes.
+std::string Part2(const Input& grid);
+
+inline const Solution<Input> kSolution = {"day10", Parse, Part1, Part2};
+
+}  // namespace day10
+
+#endif  // DAY10_SOLUTION_H_
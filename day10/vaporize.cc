@@ -0,0 +1,106 @@
+#include "day10/vaporize.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "glog/logging.h"
+
+namespace {
+
+// 0 for the half-plane swept first (straight up, through right, to just
+// before straight down), 1 for the rest.
+int Half(int delta_row, int delta_col) {
+  return delta_col > 0 || (delta_col == 0 && delta_row < 0) ? 0 : 1;
+}
+
+bool SameDirection(int delta_row1, int delta_col1, int delta_row2,
+                   int delta_col2) {
+  return Half(delta_row1, delta_col1) == Half(delta_row2, delta_col2) &&
+         int64_t{delta_row1} * delta_col2 == int64_t{delta_col1} * delta_row2;
+}
+
+}  // namespace
+
+bool ClockwiseBefore(int delta_row1, int delta_col1, int delta_row2,
+                     int delta_col2) {
+  int half1 = Half(delta_row1, delta_col1);
+  int half2 = Half(delta_row2, delta_col2);
+  if (half1 != half2) return half1 < half2;
+  // With x = col and y = -row, the second direction is clockwise of the first
+  // when x1 * y2 - y1 * x2 < 0, i.e. when col1 * row2 - row1 * col2 > 0.
+  return int64_t{delta_col1} * delta_row2 - int64_t{delta_row1} * delta_col2 >
+         0;
+}
+
+VaporizationOrder::VaporizationOrder(const AsteroidGrid& grid, PosT station) {
+  auto [station_row, station_col] = station;
+  sorted_.reserve(grid.count());
+  grid.ForEach([&](int row, int col) {
+    if (row != station_row || col != station_col) sorted_.push_back({row, col});
+  });
+  auto delta = [&](const PosT& pos) {
+    return std::make_pair(std::get<0>(pos) - station_row,
+                          std::get<1>(pos) - station_col);
+  };
+  std::sort(sorted_.begin(), sorted_.end(),
+            [&](const PosT& lhs, const PosT& rhs) {
+              auto [lhs_row, lhs_col] = delta(lhs);
+              auto [rhs_row, rhs_col] = delta(rhs);
+              if (ClockwiseBefore(lhs_row, lhs_col, rhs_row, rhs_col)) {
+                return true;
+              }
+              if (ClockwiseBefore(rhs_row, rhs_col, lhs_row, lhs_col)) {
+                return false;
+              }
+              // Same direction, so nearer is just a smaller step count.
+              return std::abs(lhs_row) + std::abs(lhs_col) <
+                     std::abs(rhs_row) + std::abs(rhs_col);
+            });
+
+  // Cut the sorted asteroids into one bucket per direction.
+  for (int i = 0; i < sorted_.size(); ++i) {
+    if (i > 0) {
+      auto [previous_row, previous_col] = delta(sorted_[i - 1]);
+      auto [row, col] = delta(sorted_[i]);
+      if (SameDirection(previous_row, previous_col, row, col)) continue;
+    }
+    bucket_starts_.push_back(i);
+  }
+  bucket_starts_.push_back(sorted_.size());
+  const int buckets = bucket_starts_.size() - 1;
+
+  // Rotation r takes from every bucket larger than r, so count the buckets
+  // per rotation, then lay each rotation's buckets out in clockwise order.
+  int rotations = 0;
+  for (int b = 0; b < buckets; ++b) {
+    rotations = std::max(rotations, bucket_starts_[b + 1] - bucket_starts_[b]);
+  }
+  rotation_starts_.assign(rotations + 1, 0);
+  for (int b = 0; b < buckets; ++b) {
+    int bucket_size = bucket_starts_[b + 1] - bucket_starts_[b];
+    for (int r = 0; r < bucket_size; ++r) ++rotation_starts_[r + 1];
+  }
+  for (int r = 0; r < rotations; ++r) {
+    rotation_starts_[r + 1] += rotation_starts_[r];
+  }
+  rotation_buckets_.resize(sorted_.size());
+  std::vector<int64_t> cursors(rotation_starts_.begin(),
+                               rotation_starts_.end() - 1);
+  for (int b = 0; b < buckets; ++b) {
+    int bucket_size = bucket_starts_[b + 1] - bucket_starts_[b];
+    for (int r = 0; r < bucket_size; ++r) rotation_buckets_[cursors[r]++] = b;
+  }
+}
+
+PosT VaporizationOrder::Vaporized(int64_t k) const {
+  CHECK_GE(k, 1);
+  CHECK_LE(k, size()) << "Only " << size() << " asteroids to vaporize.";
+  int64_t index = k - 1;
+  // The last rotation starting at or before |index|.
+  int rotation = std::upper_bound(rotation_starts_.begin(),
+                                  rotation_starts_.end(), index) -
+                 rotation_starts_.begin() - 1;
+  int bucket = rotation_buckets_[index];
+  // Each earlier rotation took the nearer asteroids of this bucket.
+  return sorted_[bucket_starts_[bucket] + rotation];
+}
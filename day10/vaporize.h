@@ -0,0 +1,50 @@
+#ifndef DAY10_VAPORIZE_H_
+#define DAY10_VAPORIZE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "day10/asteroid_grid.h"
+
+// True if the direction (|delta_row1|, |delta_col1|) comes before
+// (|delta_row2|, |delta_col2|) sweeping clockwise from straight up, with rows
+// growing downwards. Exact: directions are split into the right half-plane
+// (including straight up) and the left (including straight down), and
+// directions in the same half are ordered by the sign of their cross product.
+bool ClockwiseBefore(int delta_row1, int delta_col1, int delta_row2,
+                     int delta_col2);
+
+// The order in which a laser at a station, rotating clockwise from straight
+// up, vaporizes the other asteroids: on each rotation it takes the nearest
+// remaining asteroid in every direction it passes.
+//
+// Asteroids are sorted once into flat buckets by direction (clockwise) and
+// distance. Rotation r takes one asteroid from every bucket with more than r
+// asteroids, so the k-th vaporized asteroid comes from counting how many are
+// taken per rotation rather than by simulating the sweep.
+class VaporizationOrder {
+ public:
+  VaporizationOrder(const AsteroidGrid& grid, PosT station);
+
+  // Number of asteroids that get vaporized (all but the station).
+  int64_t size() const { return sorted_.size(); }
+
+  // The |k|-th asteroid vaporized, counting from 1.
+  PosT Vaporized(int64_t k) const;
+
+ private:
+  // Every asteroid but the station, by direction and then distance.
+  std::vector<PosT> sorted_;
+  // Bucket b (one direction) is sorted_[bucket_starts_[b], bucket_starts_[b +
+  // 1]).
+  std::vector<int> bucket_starts_;
+  // Number of asteroids vaporized before rotation r; one entry past the last
+  // rotation.
+  std::vector<int64_t> rotation_starts_;
+  // The buckets still non-empty on each rotation, in clockwise order:
+  // rotation r's are rotation_buckets_[rotation_starts_[r],
+  // rotation_starts_[r + 1]).
+  std::vector<int> rotation_buckets_;
+};
+
+#endif  // DAY10_VAPORIZE_H_
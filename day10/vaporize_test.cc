@@ -0,0 +1,154 @@
+#include "day10/vaporize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "day10/asteroid_grid.h"
+#include "gen/generators.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Clockwise angle from straight up, in [0, 2 * pi).
+double Angle(int delta_row, int delta_col) {
+  double angle = std::atan2(delta_col, -delta_row);
+  return angle < 0 ? angle + 2 * M_PI : angle;
+}
+
+// The vaporization order found by sweeping the laser around one rotation at
+// a time, taking the nearest asteroid left on each ray it passes.
+std::vector<PosT> Sweep(const AsteroidGrid& grid, PosT station) {
+  auto [station_row, station_col] = station;
+  // Rays keyed by reduced direction, each ordered nearest first.
+  std::map<std::tuple<int, int>, std::vector<PosT>> rays;
+  grid.ForEach([&](int row, int col) {
+    if (row == station_row && col == station_col) return;
+    int delta_row = row - station_row;
+    int delta_col = col - station_col;
+    int gcd = std::gcd(delta_row, delta_col);
+    rays[{delta_row / gcd, delta_col / gcd}].push_back({row, col});
+  });
+  std::vector<std::vector<PosT>> by_angle;
+  for (auto& [direction, ray] : rays) {
+    std::sort(ray.begin(), ray.end(), [&](const PosT& lhs, const PosT& rhs) {
+      return std::abs(std::get<0>(lhs) - station_row) +
+                 std::abs(std::get<1>(lhs) - station_col) <
+             std::abs(std::get<0>(rhs) - station_row) +
+                 std::abs(std::get<1>(rhs) - station_col);
+    });
+    // Taken from the back.
+    std::reverse(ray.begin(), ray.end());
+    by_angle.push_back(ray);
+  }
+  std::sort(by_angle.begin(), by_angle.end(),
+            [&](const std::vector<PosT>& lhs, const std::vector<PosT>& rhs) {
+              return Angle(std::get<0>(lhs[0]) - station_row,
+                           std::get<1>(lhs[0]) - station_col) <
+                     Angle(std::get<0>(rhs[0]) - station_row,
+                           std::get<1>(rhs[0]) - station_col);
+            });
+
+  std::vector<PosT> order;
+  for (bool any = true; any;) {
+    any = false;
+    for (std::vector<PosT>& ray : by_angle) {
+      if (ray.empty()) continue;
+      order.push_back(ray.back());
+      ray.pop_back();
+      any = true;
+    }
+  }
+  return order;
+}
+
+// Expects every k, including those past the first rotation, to match Sweep.
+void ExpectSameAsSweep(const AsteroidGrid& grid, PosT station) {
+  SCOPED_TRACE(testing::Message() << "Station " << std::get<0>(station) << ","
+                                  << std::get<1>(station));
+  std::vector<PosT> expected = Sweep(grid, station);
+  VaporizationOrder order(grid, station);
+  ASSERT_EQ(order.size(), expected.size());
+  for (int64_t k = 1; k <= order.size(); ++k) {
+    ASSERT_EQ(order.Vaporized(k), expected[k - 1]) << "k = " << k;
+  }
+}
+
+TEST(ClockwiseBeforeTest, MatchesAngles) {
+  std::vector<std::tuple<int, int>> deltas;
+  for (int row = -6; row <= 6; ++row) {
+    for (int col = -6; col <= 6; ++col) {
+      if (row != 0 || col != 0) deltas.push_back({row, col});
+    }
+  }
+  for (auto [row1, col1] : deltas) {
+    for (auto [row2, col2] : deltas) {
+      // Reduced, so equal directions compare equal exactly.
+      int gcd1 = std::gcd(row1, col1);
+      int gcd2 = std::gcd(row2, col2);
+      bool same = row1 / gcd1 == row2 / gcd2 && col1 / gcd1 == col2 / gcd2;
+      bool expected = !same && Angle(row1, col1) < Angle(row2, col2);
+      EXPECT_EQ(ClockwiseBefore(row1, col1, row2, col2), expected)
+          << "(" << row1 << "," << col1 << ") vs (" << row2 << "," << col2
+          << ")";
+    }
+  }
+}
+
+TEST(VaporizationOrderTest, MatchesSweepOnRandomFields) {
+  for (double density : {0.1, 0.5, 0.9}) {
+    for (uint64_t seed : {1, 2, 3, 4}) {
+      SCOPED_TRACE(testing::Message()
+                   << "Density " << density << ", seed " << seed);
+      AsteroidGrid grid =
+          AsteroidGrid::Parse(GenerateAsteroidField(17, 23, density, seed));
+      // A few random asteroids, and the corners, as stations.
+      std::vector<PosT> stations = {{0, 0}, {0, 22}, {16, 0}, {16, 22}};
+      std::mt19937 rng(seed);
+      for (int i = 0; i < 4; ++i) {
+        stations.push_back({static_cast<int>(rng() % 17),
+                            static_cast<int>(rng() % 23)});
+      }
+      for (auto [row, col] : stations) {
+        grid.set(row, col);
+        ExpectSameAsSweep(grid, {row, col});
+      }
+    }
+  }
+}
+
+TEST(VaporizationOrderTest, TakesOneFromEachStackPerRotation) {
+  // Full rows and columns through the station, so every axis has a stack of
+  // asteroids, and full diagonals for stacks off the axes.
+  AsteroidGrid grid(11, 11);
+  for (int i = 0; i < 11; ++i) {
+    grid.set(5, i);
+    grid.set(i, 5);
+    grid.set(i, i);
+    grid.set(i, 10 - i);
+  }
+  ExpectSameAsSweep(grid, {5, 5});
+  VaporizationOrder order(grid, {5, 5});
+  // Straight up, then up and to the right, ..., then the second rotation
+  // starts back at the top.
+  EXPECT_EQ(order.Vaporized(1), PosT(4, 5));
+  EXPECT_EQ(order.Vaporized(2), PosT(4, 6));
+  EXPECT_EQ(order.Vaporized(3), PosT(5, 6));
+  EXPECT_EQ(order.Vaporized(5), PosT(6, 5));
+  EXPECT_EQ(order.Vaporized(7), PosT(5, 4));
+  EXPECT_EQ(order.Vaporized(9), PosT(3, 5));
+  // Every stack has five, so the last rotation ends up and to the left.
+  EXPECT_EQ(order.size(), 40);
+  EXPECT_EQ(order.Vaporized(order.size()), PosT(0, 0));
+  // Also off-centre, where some stacks run out before others.
+  ExpectSameAsSweep(grid, {5, 0});
+  ExpectSameAsSweep(grid, {0, 5});
+  ExpectSameAsSweep(grid, {3, 3});
+}
+
+}  // namespace
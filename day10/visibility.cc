@@ -0,0 +1,100 @@
+#include "day10/visibility.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+#include "glog/logging.h"
+
+VisibilityScanner::VisibilityScanner(int rows, int cols)
+    : rows_(rows), cols_(cols) {
+  CHECK_GT(rows, 0);
+  CHECK_GT(cols, 0);
+  // Reduce every offset that fits on the map once, up front, rather than
+  // taking a gcd and two divisions for every pair of asteroids.
+  const int64_t stride = 2 * int64_t{cols} - 1;
+  const int64_t slots = (2 * int64_t{rows} - 1) * stride;
+  // Slots are stored as int32_t to halve the table.
+  CHECK_LE(slots, std::numeric_limits<int32_t>::max())
+      << rows << "x" << cols << " is too large to scan.";
+  auto directions = std::make_shared<std::vector<int32_t>>(slots);
+  for (int delta_row = 1 - rows; delta_row < rows; ++delta_row) {
+    for (int delta_col = 1 - cols; delta_col < cols; ++delta_col) {
+      int gcd = std::max(1, std::gcd(delta_row, delta_col));
+      (*directions)[(delta_row + rows - 1) * stride + delta_col + cols - 1] =
+          (delta_row / gcd + rows - 1) * stride + delta_col / gcd + cols - 1;
+    }
+  }
+  directions_ = std::move(directions);
+  seen_.assign(directions_->size(), 0);
+}
+
+int VisibilityScanner::CountVisible(const AsteroidGrid& grid, PosT origin) {
+  DCHECK_LE(grid.rows(), rows_);
+  DCHECK_LE(grid.cols(), cols_);
+  DCHECK(grid.test(origin));
+  if (++generation_ == 0) {
+    // Wrapped around; old stamps could now look current.
+    std::fill(seen_.begin(), seen_.end(), 0);
+    generation_ = 1;
+  }
+  auto [origin_row, origin_col] = origin;
+  const int64_t stride = 2 * int64_t{cols_} - 1;
+  // Offsets are relative to the origin, so index from its own slot.
+  const int32_t* directions =
+      directions_->data() + (rows_ - 1 - origin_row) * stride + cols_ - 1 -
+      origin_col;
+  int visible = 0;
+  grid.ForEach([&](int row, int col) {
+    uint32_t& slot = seen_[directions[row * stride + col]];
+    if (slot != generation_) {
+      slot = generation_;
+      ++visible;
+    }
+  });
+  // The origin reduces to its own (0, 0) slot, which it just counted.
+  return visible - 1;
+}
+
+Station FindBestStation(const AsteroidGrid& grid) {
+  VisibilityScanner scanner(grid.rows(), grid.cols());
+  Station best = {{-1, -1}, -1};
+  grid.ForEach([&](int row, int col) {
+    int visible = scanner.CountVisible(grid, {row, col});
+    if (visible > best.visible) best = {{row, col}, visible};
+  });
+  CHECK_GE(best.visible, 0) << "No asteroids.";
+  return best;
+}
+
+Station FindBestStation(const AsteroidGrid& grid, ThreadPool& pool) {
+  std::vector<VisibilityScanner> scanners(
+      pool.size(), VisibilityScanner(grid.rows(), grid.cols()));
+  std::vector<Station> bests(pool.size(), Station{{-1, -1}, -1});
+  // Better is more visible, then earlier.
+  auto better = [](const Station& lhs, const Station& rhs) {
+    return lhs.visible > rhs.visible ||
+           (lhs.visible == rhs.visible && lhs.pos < rhs.pos);
+  };
+  // One row of origins at a time: every origin costs the same, but cores
+  // don't.
+  pool.ParallelFor(grid.rows(), 1, [&](int worker, int64_t begin,
+                                       int64_t end) {
+    for (int row = begin; row < end; ++row) {
+      for (int col = 0; col < grid.cols(); ++col) {
+        if (!grid.test(row, col)) continue;
+        Station candidate = {{row, col},
+                             scanners[worker].CountVisible(grid, {row, col})};
+        if (better(candidate, bests[worker])) bests[worker] = candidate;
+      }
+    }
+  });
+
+  Station best = bests[0];
+  for (const Station& candidate : bests) {
+    if (better(candidate, best)) best = candidate;
+  }
+  CHECK_GE(best.visible, 0) << "No asteroids.";
+  return best;
+}
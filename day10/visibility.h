@@ -0,0 +1,61 @@
+#ifndef DAY10_VISIBILITY_H_
+#define DAY10_VISIBILITY_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "day10/asteroid_grid.h"
+
+// Counts the asteroids visible from an origin. Every other asteroid is
+// bucketed by its reduced direction (dr / g, dc / g) where g = gcd(dr, dc):
+// asteroids in the same bucket are on the same ray and all but the nearest
+// are hidden, so the number visible is the number of distinct directions.
+// That's O(n) per origin with no walking of the grid in between.
+//
+// Every (dr, dc) that fits on the map is reduced once, when the scanner is
+// made, into a table shared by copies of the scanner. Directions seen are
+// tracked in a second table stamped with the origin they were last seen from,
+// so it never needs clearing between origins; that one is per scanner, so use
+// one copy per thread.
+//
+// Both tables have a slot for every offset, (2 * rows - 1) * (2 * cols - 1)
+// of them, so memory grows with the map's area rather than its asteroids:
+// 16 bytes per cell for the shared table and 16 more per thread for the
+// stamps. Maps with more than 2^31 slots (about 23000 x 23000) aren't
+// supported.
+class VisibilityScanner {
+ public:
+  // Scans maps of at most |rows| x |cols|.
+  VisibilityScanner(int rows, int cols);
+
+  // Number of asteroids on |grid| visible from |origin|, which must itself be
+  // an asteroid.
+  int CountVisible(const AsteroidGrid& grid, PosT origin);
+
+ private:
+  int rows_;
+  int cols_;
+  // For each offset slot, the slot of its reduced direction.
+  std::shared_ptr<const std::vector<int32_t>> directions_;
+  // For each direction slot, the generation in which it was last seen.
+  std::vector<uint32_t> seen_;
+  uint32_t generation_ = 0;
+};
+
+// The asteroid that can see the most other asteroids.
+struct Station {
+  PosT pos;
+  int visible;
+};
+
+// Finds the best station on |grid|, which must have at least one asteroid.
+Station FindBestStation(const AsteroidGrid& grid);
+
+// Same as above, with the rows of origins spread across |pool|. Each worker
+// has its own scanner and keeps its own best, and those are merged at the end;
+// ties go to the earliest asteroid in row-major order either way.
+Station FindBestStation(const AsteroidGrid& grid, ThreadPool& pool);
+
+#endif  // DAY10_VISIBILITY_H_
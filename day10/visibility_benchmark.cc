@@ -0,0 +1,54 @@
+// Scaling of the best-station search with map size and thread count.
+
+#include "benchmark/benchmark.h"
+#include "common/thread_pool.h"
+#include "day10/asteroid_grid.h"
+#include "day10/visibility.h"
+#include "gen/generators.h"
+
+namespace {
+
+void BM_Serial(benchmark::State& state) {
+  AsteroidGrid grid = AsteroidGrid::Parse(
+      GenerateAsteroidField(state.range(0), state.range(0), 0.5, 1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindBestStation(grid));
+  }
+  state.SetItemsProcessed(state.iterations() * grid.count());
+}
+
+void BM_Parallel(benchmark::State& state) {
+  AsteroidGrid grid = AsteroidGrid::Parse(
+      GenerateAsteroidField(state.range(0), state.range(0), 0.5, 1));
+  ThreadPool pool(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindBestStation(grid, pool));
+  }
+  state.SetItemsProcessed(state.iterations() * grid.count());
+}
+
+// Sides of square maps, half asteroids, with about 2^10, 2^14, 10^5 and 2^18
+// asteroids. Each origin scans every asteroid, so time grows with the square
+// of the map.
+constexpr int kSides[] = {46, 182, 448, 725};
+
+// Map side and threads.
+void ParallelArgs(benchmark::internal::Benchmark* benchmark) {
+  for (int side : kSides) {
+    for (int threads : {1, 2, 4, 8, 16}) {
+      benchmark->Args({side, threads});
+    }
+  }
+}
+
+BENCHMARK(BM_Serial)
+    ->Arg(kSides[0])
+    ->Arg(kSides[1])
+    ->Arg(kSides[2])
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Parallel)
+    ->Apply(ParallelArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,11 @@
+#include "common/day_benchmark.h"
+#include "day2/solution.h"
+
+namespace {
+
+// Both parts patch fixed positions of one specific program, so only the real
+// input is meaningful.
+const bool registered = RegisterSolutionBenchmarks(
+    day2::kSolution, "day2/input.txt", nullptr, {});
+
+}  // namespace
@@ -0,0 +1,8 @@
+#include "day2/embedded.h"
+
+namespace day2 {
+
+// What //day2 prints for input.txt, using Machine.
+static_assert(kEmbeddedPart1 == 5866714);
+
+}  // namespace day2
@@ -0,0 +1,34 @@
+#ifndef DAY2_EMBEDDED_H_
+#define DAY2_EMBEDDED_H_
+
+#include <cstdint>
+
+#include "intcode/constexpr_machine.h"
+
+// Part 1 for the checked-in input.txt, worked out by the compiler. Part 2
+// searches 10,000 nouns and verbs, which is more than the compiler's constant
+// evaluation budget allows.
+namespace day2 {
+
+inline constexpr int64_t kEmbeddedProgram[] = {
+#include "day2/input.txt"
+};
+
+// What is left at position 0 after running the embedded program with |noun|
+// and |verb| in positions 1 and 2.
+constexpr int64_t RunEmbedded(int64_t noun, int64_t verb) {
+  ConstexprMachine<sizeof(kEmbeddedProgram) / sizeof(int64_t)> machine(
+      kEmbeddedProgram);
+  machine.memory(1) = noun;
+  machine.memory(2) = verb;
+  if (machine.Execute() != kHaltInstruction) {
+    ConstexprMachineFailure("Program is waiting for input.");
+  }
+  return machine.memory(0);
+}
+
+inline constexpr int64_t kEmbeddedPart1 = RunEmbedded(12, 2);
+
+}  // namespace day2
+
+#endif  // DAY2_EMBEDDED_H_
@@ -0,0 +1,44 @@
+#include "day2/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "glog/logging.h"
+
+namespace day2 {
+namespace {
+
+// Runs the program with |noun| and |verb| in positions 1 and 2 and returns
+// what is left at position 0.
+int64_t Run(const Memory& memory, int64_t noun, int64_t verb) {
+  Memory modified = memory;
+  modified[1] = noun;
+  modified[2] = verb;
+  Machine machine(modified);
+  machine.Execute();
+  return machine.memory()[0];
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) { return ReadMemory(text); }
+
+std::string Part1(const Input& memory) {
+  // To do this, before running the program, replace position 1 with the value
+  // 12 and replace position 2 with the value 2. What value is left at position
+  // 0 after the program halts?
+  return absl::StrCat(Run(memory, 12, 2));
+}
+
+std::string Part2(const Input& memory) {
+  // Find values for 1 and 2 (above) that produce the output 19690720.
+  // What is 100 * noun + verb?
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 100; ++j) {
+      if (Run(memory, i, j) == 19690720) {
+        return absl::StrCat((100 * i) + j);
+      }
+    }
+  }
+  LOG(FATAL) << "No noun and verb give 19690720.";
+}
+
+}  // namespace day2
@@ -0,0 +1,25 @@
+#ifndef DAY2_SOLUTION_H_
+#define DAY2_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "intcode/intcode.h"
+
+namespace day2 {
+
+// The intcode program.
+typedef Memory Input;
+
+Input Parse(absl::string_view text);
+// The value left at position 0 when run with noun 12 and verb 2.
+std::string Part1(const Input& memory);
+// 100 * noun + verb for the noun and verb that leave 19690720 at position 0.
+std::string Part2(const Input& memory);
+
+inline const Solution<Input> kSolution = {"day2", Parse, Part1, Part2};
+
+}  // namespace day2
+
+#endif  // DAY2_SOLUTION_H_
@@ -0,0 +1,13 @@
+#include "common/day_benchmark.h"
+#include "day3/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are moves per wire, each up to 100 long.
+const bool registered = RegisterSolutionBenchmarks(
+    day3::kSolution, "day3/input.txt",
+    [](int64_t size) { return GenerateWirePaths(size, 100, size); },
+    {1 << 8, 1 << 12, 1 << 16});
+
+}  // namespace
@@ -0,0 +1,113 @@
+#include "day3/solution.h"
+
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <tuple>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "common/input.h"
+#include "glog/logging.h"
+
+namespace day3 {
+namespace {
+
+std::vector<Vector> ParsePath(absl::string_view line) {
+  std::vector<Vector> path;
+  for (auto s : Split(line, ',')) {
+    char dir = s[0];
+    int64_t magnitude;
+    CHECK(ParseInt(s.substr(1), &magnitude)) << "Bad vector: " << s;
+    path.push_back({dir, static_cast<int>(magnitude)});
+  }
+  return path;
+}
+
+struct Pos {
+  int x;
+  int y;
+};
+
+Pos Step(Pos pos, std::tuple<int, int> step) {
+  auto [x_step, y_step] = step;
+  return {pos.x + x_step, pos.y + y_step};
+}
+
+// Walks the given path from the origin and calls visit with x, y, and current
+// path length.
+void WalkPath(const std::vector<Vector>& path,
+              const std::function<void(int, int, int)>& visit) {
+  int path_length = 0;
+
+  Pos pos{0, 0};
+  std::tuple<int, int> step;
+  for (auto vec : path) {
+    if (vec.dir == 'U') {
+      step = {0, 1};
+    } else if (vec.dir == 'D') {
+      step = {0, -1};
+    } else if (vec.dir == 'L') {
+      step = {-1, 0};
+    } else {
+      step = {1, 0};
+    }
+
+    // Walk the vector, visiting each element.
+    for (int i = 0; i < vec.magnitude; ++i) {
+      visit(pos.x, pos.y, path_length++);
+      pos = Step(pos, step);
+    }
+  }
+}
+
+int64_t Key(int x, int y) {
+  return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+// Calls |crossing(x, y, steps)| for every point the second wire visits that
+// the first wire also visited (other than the origin), with the combined
+// steps both wires took to get there.
+void ForEachCrossing(const Input& input,
+                     const std::function<void(int, int, int)>& crossing) {
+  // Only the points the first wire visits are stored, with the steps it took
+  // to first reach each one, so memory grows with the wire rather than with
+  // the area it spans.
+  absl::flat_hash_map<int64_t, int> first_steps;
+  WalkPath(input.first_path, [&](int x, int y, int path_length) {
+    first_steps.try_emplace(Key(x, y), path_length);
+  });
+  // Erase the origin so we don't accidentally intersect with it.
+  first_steps.erase(Key(0, 0));
+
+  WalkPath(input.second_path, [&](int x, int y, int path_length) {
+    auto iter = first_steps.find(Key(x, y));
+    if (iter != first_steps.end()) crossing(x, y, iter->second + path_length);
+  });
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) {
+  std::vector<absl::string_view> lines = SplitLines(text);
+  CHECK_EQ(lines.size(), 2);
+  return {ParsePath(lines[0]), ParsePath(lines[1])};
+}
+
+std::string Part1(const Input& input) {
+  int manhattan_distance = INT_MAX;
+  ForEachCrossing(input, [&](int x, int y, int steps) {
+    manhattan_distance = std::min(manhattan_distance, std::abs(x) + std::abs(y));
+  });
+  return absl::StrCat(manhattan_distance);
+}
+
+std::string Part2(const Input& input) {
+  int walk_distance = INT_MAX;
+  ForEachCrossing(input, [&](int x, int y, int steps) {
+    walk_distance = std::min(walk_distance, steps);
+  });
+  return absl::StrCat(walk_distance);
+}
+
+}  // namespace day3
@@ -0,0 +1,33 @@
+#ifndef DAY3_SOLUTION_H_
+#define DAY3_SOLUTION_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+
+namespace day3 {
+
+struct Vector {
+  char dir;  // U, D, L, R
+  int magnitude;
+};
+
+// The two wires' paths from the origin.
+struct Input {
+  std::vector<Vector> first_path;
+  std::vector<Vector> second_path;
+};
+
+Input Parse(absl::string_view text);
+// Manhattan distance from the origin to the closest crossing.
+std::string Part1(const Input& input);
+// Fewest combined steps the wires take to reach a crossing.
+std::string Part2(const Input& input);
+
+inline const Solution<Input> kSolution = {"day3", Parse, Part1, Part2};
+
+}  // namespace day3
+
+#endif  // DAY3_SOLUTION_H_
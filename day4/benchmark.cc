@@ -0,0 +1,13 @@
+#include "absl/strings/str_cat.h"
+#include "common/day_benchmark.h"
+#include "day4/solution.h"
+
+namespace {
+
+// Sizes are the number of passwords in the range.
+const bool registered = RegisterSolutionBenchmarks(
+    day4::kSolution, "day4/input.txt",
+    [](int64_t size) { return absl::StrCat(100000, "-", 100000 + size); },
+    {1 << 10, 1 << 16, 1 << 19});
+
+}  // namespace
@@ -0,0 +1,87 @@
+#include "day4/solution.h"
+
+#include <climits>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "common/input.h"
+#include "glog/logging.h"
+
+namespace day4 {
+namespace {
+
+bool IsValidPart1(int pwd) {
+  bool adjacent_same = false;
+  int last = INT_MAX;
+  while (pwd > 0) {
+    int tens = pwd % 10;
+    if (tens == last) {
+      adjacent_same = true;
+    }
+    if (tens > last) return false;
+    last = tens;
+    pwd /= 10;
+  }
+  return adjacent_same;
+}
+
+bool IsValidPart2(int pwd) {
+  // Part1 ensures there's at least one repeated digit and they are in order.
+  if (!IsValidPart1(pwd)) return false;
+
+  std::vector<int> digits;
+  while (pwd > 0) {
+    digits.push_back(pwd % 10);
+    pwd /= 10;
+  }
+
+  // See if there's a run of exactly two.
+  for (int i = 0; i < digits.size() - 1; ++i) {
+    // If there's a run from this digit but not longer than 2, this counts.
+    if (digits[i] == digits[i + 1]) {
+      int repeat = digits[i];
+      // Eat the rest of the repeated digits (if there are any).
+      int j = i + 2;
+      for (; j < digits.size() && digits[j] == repeat; ++j) {
+      }
+      // If we didn't walk any further, this is run of two.
+      if (j == i + 2) {
+        return true;
+      }
+      // We ate more digits, so jump to the end of the sequence.
+      i = j - 1;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) {
+  std::vector<absl::string_view> lines = SplitLines(text);
+  CHECK(!lines.empty());
+  std::vector<absl::string_view> parts = Split(lines[0], '-');
+  CHECK_EQ(parts.size(), 2);
+  Input range;
+  CHECK(ParseInt(parts[0], &range.min));
+  CHECK(ParseInt(parts[1], &range.max));
+  return range;
+}
+
+std::string Part1(const Input& range) {
+  int count = 0;
+  for (int i = range.min; i <= range.max; ++i) {
+    if (IsValidPart1(i)) ++count;
+  }
+  return absl::StrCat(count);
+}
+
+std::string Part2(const Input& range) {
+  int count = 0;
+  for (int i = range.min; i <= range.max; ++i) {
+    if (IsValidPart2(i)) ++count;
+  }
+  return absl::StrCat(count);
+}
+
+}  // namespace day4
@@ -0,0 +1,29 @@
+#ifndef DAY4_SOLUTION_H_
+#define DAY4_SOLUTION_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+
+namespace day4 {
+
+// The range of passwords to check, inclusive.
+struct Input {
+  int64_t min;
+  int64_t max;
+};
+
+Input Parse(absl::string_view text);
+// Passwords in the range with two equal adjacent digits and no decreasing
+// digits.
+std::string Part1(const Input& range);
+// As part 1, but some pair of equal digits must not be part of a longer run.
+std::string Part2(const Input& range);
+
+inline const Solution<Input> kSolution = {"day4", Parse, Part1, Part2};
+
+}  // namespace day4
+
+#endif  // DAY4_SOLUTION_H_
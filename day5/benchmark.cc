@@ -0,0 +1,18 @@
+#include <cmath>
+
+#include "common/day_benchmark.h"
+#include "day5/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are the number of iterations of a doubly nested loop, which ignores
+// the system id and outputs its count.
+const bool registered = RegisterSolutionBenchmarks(
+    day5::kSolution, "day5/input.txt",
+    [](int64_t size) {
+      return GenerateIntcodeLoops(2, std::llround(std::sqrt(size)));
+    },
+    {1 << 10, 1 << 16, 1 << 20});
+
+}  // namespace
@@ -0,0 +1,9 @@
+#include "day5/embedded.h"
+
+namespace day5 {
+
+// What //day5 prints for input.txt, using Machine.
+static_assert(kEmbeddedPart1 == 3122865);
+static_assert(kEmbeddedPart2 == 773660);
+
+}  // namespace day5
@@ -0,0 +1,31 @@
+#ifndef DAY5_EMBEDDED_H_
+#define DAY5_EMBEDDED_H_
+
+#include <array>
+#include <cstdint>
+
+#include "intcode/constexpr_machine.h"
+
+// The answers for the checked-in input.txt, worked out by the compiler.
+namespace day5 {
+
+inline constexpr int64_t kEmbeddedProgram[] = {
+#include "day5/input.txt"
+};
+
+// Room for the program and the memory it uses beyond it.
+inline constexpr size_t kEmbeddedMemorySize = 1024;
+
+// The last output of the embedded program given |input|.
+constexpr int64_t RunEmbedded(int64_t input) {
+  return RunConstexprMachine<kEmbeddedMemorySize>(
+             kEmbeddedProgram, std::array<int64_t, 1>{input})
+      .last_output();
+}
+
+inline constexpr int64_t kEmbeddedPart1 = RunEmbedded(1);
+inline constexpr int64_t kEmbeddedPart2 = RunEmbedded(5);
+
+}  // namespace day5
+
+#endif  // DAY5_EMBEDDED_H_
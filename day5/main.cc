@@ -1,31 +1,36 @@
-#include <fstream>
-#include <iostream>
-
-#include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
-#include "absl/strings/numbers.h"
-#include "absl/strings/str_split.h"
-#include "absl/strings/strip.h"
-#include "absl/strings/substitute.h"
-#include "absl/types/optional.h"
+#include "common/input.h"
+#include "common/perf.h"
+#include "day5/embedded.h"
+#include "day5/solution.h"
+#include "gflags/gflags.h"
 #include "glog/logging.h"
-#include "intcode/intcode.h"
 
 int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
   google::InstallFailureSignalHandler();
   FLAGS_logtostderr = 1;
 
-  std::ifstream file(argv[1]);
-  CHECK(file);
-
-  Memory memory = ReadMemoryFromFile(file);
+  if (argc < 2) {
+    // No input given: report what the compiler worked out for input.txt.
+    LOG(INFO) << "PART 1: " << day5::kEmbeddedPart1;
+    LOG(INFO) << "PART 2: " << day5::kEmbeddedPart2;
+    return 0;
+  }
 
-  // Part 1: use 1 as input, print output[output.size - 1].
-  LOG(INFO) << "PART 1 OUTPUT";
-  RunMachine(memory, 1);
+  MappedFile file(argv[1]);
+  day5::Input memory = [&] {
+    ScopedPhase phase("parse");
+    return day5::Parse(file.contents());
+  }();
 
-  LOG(INFO) << "PART 2 OUTPUT";
-  RunMachine(memory, 5);
+  {
+    ScopedPhase phase("part1");
+    LOG(INFO) << "PART 1: " << day5::Part1(memory);
+  }
+  {
+    ScopedPhase phase("part2");
+    LOG(INFO) << "PART 2: " << day5::Part2(memory);
+  }
   return 0;
 }
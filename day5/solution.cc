@@ -0,0 +1,35 @@
+#include "day5/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "glog/logging.h"
+
+namespace day5 {
+namespace {
+
+// Runs the diagnostics for system |id|. Every output but the last is a test
+// result, which must be zero; the last is the diagnostic code.
+int64_t RunDiagnostics(const Memory& memory, int64_t id) {
+  Machine machine(memory);
+  machine.input() = {id};
+  CHECK(machine.Execute() == kHaltInstruction);
+  const Storage& output = machine.output();
+  CHECK(!output.empty());
+  for (int i = 0; i + 1 < output.size(); ++i) {
+    CHECK_EQ(output[i], 0) << "Test " << i << " failed.";
+  }
+  return output.back();
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) { return ReadMemory(text); }
+
+std::string Part1(const Input& memory) {
+  return absl::StrCat(RunDiagnostics(memory, 1));
+}
+
+std::string Part2(const Input& memory) {
+  return absl::StrCat(RunDiagnostics(memory, 5));
+}
+
+}  // namespace day5
@@ -0,0 +1,25 @@
+#ifndef DAY5_SOLUTION_H_
+#define DAY5_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "intcode/intcode.h"
+
+namespace day5 {
+
+// The diagnostic program.
+typedef Memory Input;
+
+Input Parse(absl::string_view text);
+// The diagnostic code for system 1 (the air conditioner).
+std::string Part1(const Input& memory);
+// The diagnostic code for system 5 (the thermal radiator controller).
+std::string Part2(const Input& memory);
+
+inline const Solution<Input> kSolution = {"day5", Parse, Part1, Part2};
+
+}  // namespace day5
+
+#endif  // DAY5_SOLUTION_H_
@@ -0,0 +1,14 @@
+#include "common/day_benchmark.h"
+#include "day6/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are numbers of bodies, in a tree an eighth as deep with at most four
+// satellites per body.
+const bool registered = RegisterSolutionBenchmarks(
+    day6::kSolution, "day6/input.txt",
+    [](int64_t size) { return GenerateOrbits(size, size / 8, 4, size); },
+    {1 << 10, 1 << 16, 1 << 20});
+
+}  // namespace
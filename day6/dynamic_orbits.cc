@@ -0,0 +1,231 @@
+#include "day6/dynamic_orbits.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "glog/logging.h"
+
+namespace {
+
+// MinBalance of no tokens.
+constexpr int kNoBalance = std::numeric_limits<int>::max();
+
+}  // namespace
+
+void DynamicOrbits::AddOrbit(absl::string_view center,
+                             absl::string_view satellite) {
+  bool known = Contains(satellite);
+  BodyId child = FindOrAdd(satellite);
+  BodyId parent = FindOrAdd(center);
+  if (known) {
+    CHECK_EQ(Depth(child), 0) << satellite << " already orbits something.";
+  }
+  CHECK(!IsWithin(parent, child))
+      << center << " orbits " << satellite << "; that would be a cycle.";
+  Attach(child, parent);
+}
+
+void DynamicOrbits::Reparent(absl::string_view satellite,
+                             absl::string_view new_center) {
+  BodyId child = Id(satellite);
+  BodyId parent = FindOrAdd(new_center);
+  CHECK(!IsWithin(parent, child))
+      << new_center << " orbits " << satellite << "; that would be a cycle.";
+  Attach(child, parent);
+}
+
+void DynamicOrbits::Remove(absl::string_view body) {
+  auto iter = ids_.find(body);
+  CHECK(iter != ids_.end()) << "Unknown body: " << body;
+  BodyId id = iter->second;
+
+  // The body's own orbits go away, and everything orbiting it is one orbit
+  // closer to the root.
+  total_orbits_ -= Depth(id) + SubtreeSize(id) - 1;
+
+  // Drop the two tokens; the satellites' tours between them stay where they
+  // are, so they now belong to the body's center.
+  int enter_position = PrefixThrough(Enter(id)).tokens - 1;
+  int exit_position = PrefixThrough(Exit(id)).tokens - 1;
+  auto [before, rest] = Split(root_, enter_position);
+  auto [enter, rest2] = Split(rest, 1);
+  auto [satellites, rest3] = Split(rest2, exit_position - enter_position - 1);
+  auto [exit, after] = Split(rest3, 1);
+  root_ = Merge(Merge(before, satellites), after);
+
+  ids_.erase(iter);
+  free_ids_.push_back(id);
+}
+
+int DynamicOrbits::Transfers(absl::string_view from,
+                             absl::string_view to) const {
+  BodyId a = Id(from);
+  BodyId b = Id(to);
+  CHECK_GT(Depth(a), 0) << from << " orbits nothing.";
+  CHECK_GT(Depth(b), 0) << to << " orbits nothing.";
+  int a_position = PrefixThrough(Enter(a)).tokens - 1;
+  int b_position = PrefixThrough(Enter(b)).tokens - 1;
+  // Between the two enter tokens the balance never drops below one more than
+  // the depth of their lowest common ancestor, and reaches it.
+  int lca_depth = MinBalance(root_, std::min(a_position, b_position),
+                             std::max(a_position, b_position) + 1, 0) -
+                  1;
+  CHECK_GE(lca_depth, 0) << from << " and " << to << " are in different trees.";
+  int distance = Depth(a) + Depth(b) - 2 * lca_depth;
+  // The centers are one orbit nearer each other than the bodies, at each end
+  // where a body isn't the other's ancestor.
+  if (IsWithin(a, b) || IsWithin(b, a)) return distance;
+  return distance - 2;
+}
+
+BodyId DynamicOrbits::Id(absl::string_view body) const {
+  auto iter = ids_.find(body);
+  CHECK(iter != ids_.end()) << "Unknown body: " << body;
+  return iter->second;
+}
+
+BodyId DynamicOrbits::FindOrAdd(absl::string_view body) {
+  auto iter = ids_.find(body);
+  if (iter != ids_.end()) return iter->second;
+
+  BodyId id;
+  if (free_ids_.empty()) {
+    id = nodes_.size() / 2;
+    nodes_.resize(nodes_.size() + 2);
+  } else {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  }
+  ids_.try_emplace(body, id);
+
+  // New bodies start out as roots at the end of the tour.
+  for (int node : {Enter(id), Exit(id)}) {
+    nodes_[node] = Node();
+    nodes_[node].priority = rng_();
+    Update(node);
+  }
+  root_ = Merge(root_, Merge(Enter(id), Exit(id)));
+  return id;
+}
+
+int DynamicOrbits::Depth(BodyId body) const {
+  // The body's own enter token is still open, so don't count it.
+  return PrefixThrough(Enter(body)).balance - 1;
+}
+
+int DynamicOrbits::SubtreeSize(BodyId body) const {
+  return PrefixThrough(Exit(body)).enters - PrefixThrough(Enter(body)).enters +
+         1;
+}
+
+bool DynamicOrbits::IsWithin(BodyId body, BodyId ancestor) const {
+  int position = PrefixThrough(Enter(body)).tokens;
+  return PrefixThrough(Enter(ancestor)).tokens <= position &&
+         position <= PrefixThrough(Exit(ancestor)).tokens;
+}
+
+void DynamicOrbits::Attach(BodyId body, BodyId center) {
+  // Every body in the moved span shifts depth by the same amount.
+  int old_depth = Depth(body);
+  int new_depth = Depth(center) + 1;
+  total_orbits_ += int64_t{SubtreeSize(body)} * (new_depth - old_depth);
+
+  int start = PrefixThrough(Enter(body)).tokens - 1;
+  int end = PrefixThrough(Exit(body)).tokens;
+  auto [before, rest] = Split(root_, start);
+  auto [span, after] = Split(rest, end - start);
+  root_ = Merge(before, after);
+
+  // Splice in directly after the center's enter token.
+  auto [head, tail] = Split(root_, PrefixThrough(Enter(center)).tokens);
+  root_ = Merge(Merge(head, span), tail);
+}
+
+void DynamicOrbits::Update(int node) {
+  Node& n = nodes_[node];
+  bool is_enter = node % 2 == 0;
+  n.count = 1 + Count(n.left) + Count(n.right);
+  n.enters = (is_enter ? 1 : 0) + Enters(n.left) + Enters(n.right);
+  n.balance = (is_enter ? 1 : -1) + Balance(n.left) + Balance(n.right);
+  int through_self = Balance(n.left) + (is_enter ? 1 : -1);
+  n.min_balance = through_self;
+  if (n.left != -1) {
+    n.min_balance = std::min(n.min_balance, nodes_[n.left].min_balance);
+  }
+  if (n.right != -1) {
+    n.min_balance =
+        std::min(n.min_balance, through_self + nodes_[n.right].min_balance);
+  }
+  if (n.left != -1) nodes_[n.left].parent = node;
+  if (n.right != -1) nodes_[n.right].parent = node;
+}
+
+int DynamicOrbits::Merge(int left, int right) {
+  if (left == -1) return right;
+  if (right == -1) return left;
+  int root;
+  if (nodes_[left].priority > nodes_[right].priority) {
+    nodes_[left].right = Merge(nodes_[left].right, right);
+    root = left;
+  } else {
+    nodes_[right].left = Merge(left, nodes_[right].left);
+    root = right;
+  }
+  Update(root);
+  // Callers re-parent this if it ends up beneath another node.
+  nodes_[root].parent = -1;
+  return root;
+}
+
+std::pair<int, int> DynamicOrbits::Split(int node, int count) {
+  if (node == -1) return {-1, -1};
+  std::pair<int, int> result;
+  if (Count(nodes_[node].left) >= count) {
+    auto [left, right] = Split(nodes_[node].left, count);
+    nodes_[node].left = right;
+    result = {left, node};
+  } else {
+    auto [left, right] =
+        Split(nodes_[node].right, count - Count(nodes_[node].left) - 1);
+    nodes_[node].right = left;
+    result = {node, right};
+  }
+  Update(node);
+  if (result.first != -1) nodes_[result.first].parent = -1;
+  if (result.second != -1) nodes_[result.second].parent = -1;
+  return result;
+}
+
+DynamicOrbits::Prefix DynamicOrbits::PrefixThrough(int node) const {
+  auto add_left_and_self = [this](Prefix& prefix, int n) {
+    int left = nodes_[n].left;
+    bool is_enter = n % 2 == 0;
+    prefix.tokens += Count(left) + 1;
+    prefix.enters += Enters(left) + (is_enter ? 1 : 0);
+    prefix.balance += Balance(left) + (is_enter ? 1 : -1);
+  };
+  Prefix prefix;
+  add_left_and_self(prefix, node);
+  // Climbing out of a right subtree passes everything to the left of it.
+  for (int child = node, parent = nodes_[node].parent; parent != -1;
+       child = parent, parent = nodes_[parent].parent) {
+    if (nodes_[parent].right == child) add_left_and_self(prefix, parent);
+  }
+  return prefix;
+}
+
+int DynamicOrbits::MinBalance(int node, int begin, int end, int offset) const {
+  if (node == -1 || begin >= end) return kNoBalance;
+  if (begin <= 0 && end >= Count(node)) {
+    return offset + nodes_[node].min_balance;
+  }
+  const Node& n = nodes_[node];
+  int left_count = Count(n.left);
+  int through_self = offset + Balance(n.left) + (node % 2 == 0 ? 1 : -1);
+  int result = MinBalance(n.left, begin, std::min(end, left_count), offset);
+  if (begin <= left_count && left_count < end) {
+    result = std::min(result, through_self);
+  }
+  return std::min(result, MinBalance(n.right, begin - left_count - 1,
+                                     end - left_count - 1, through_self));
+}
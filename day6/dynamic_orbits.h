@@ -0,0 +1,124 @@
+#ifndef DAY6_DYNAMIC_ORBITS_H_
+#define DAY6_DYNAMIC_ORBITS_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "day6/orbit_tree.h"
+
+// An orbit map that changes over time. Bodies can be added, removed and moved
+// to a new center while the total number of direct and indirect orbits (part
+// 1) and the size of every subtree are kept current, and transfers (part 2)
+// answered, without rebuilding.
+//
+// The whole forest is stored as one Euler tour in an implicit treap: each body
+// contributes an "enter" token, followed by the tours of its satellites,
+// followed by an "exit" token. A body's depth is the number of enter tokens
+// still open when its own enter token is reached, and moving a body with
+// everything orbiting it is cutting one contiguous span out of the tour and
+// splicing it in after the new center's enter token. The shallowest body
+// between two enter tokens is their lowest common ancestor, found from the
+// smallest running balance between them. Every operation is O(log n)
+// expected.
+class DynamicOrbits {
+ public:
+  DynamicOrbits() = default;
+
+  // Makes |satellite| orbit |center|, adding either body if it is unknown. If
+  // |satellite| is already known it must not be orbiting anything yet (it
+  // may already have satellites of its own, though).
+  void AddOrbit(absl::string_view center, absl::string_view satellite);
+
+  // Moves |satellite|, along with everything orbiting it, to orbit
+  // |new_center| instead. |new_center| is added if it is unknown and must not
+  // be orbiting |satellite|.
+  void Reparent(absl::string_view satellite, absl::string_view new_center);
+
+  // Removes |body|. Anything that was orbiting it now orbits the body it was
+  // orbiting (or nothing, if it was a root).
+  void Remove(absl::string_view body);
+
+  // Number of bodies.
+  int size() const { return ids_.size(); }
+  bool Contains(absl::string_view body) const { return ids_.contains(body); }
+
+  // Sum of direct and indirect orbits over every body.
+  int64_t TotalOrbits() const { return total_orbits_; }
+  // Number of direct and indirect orbits of |body|.
+  int Depth(absl::string_view body) const { return Depth(Id(body)); }
+  // Number of bodies directly or indirectly orbiting |body|, plus |body|.
+  int SubtreeSize(absl::string_view body) const {
+    return SubtreeSize(Id(body));
+  }
+  // Number of orbital transfers to move from the body |from| is orbiting to
+  // the body |to| is orbiting (part 2). Both must orbit something, in the
+  // same tree.
+  int Transfers(absl::string_view from, absl::string_view to) const;
+
+ private:
+  // Treap node for one token of the tour. Body b owns nodes 2b (enter) and
+  // 2b + 1 (exit). Links are node indices, -1 for none.
+  struct Node {
+    int left = -1;
+    int right = -1;
+    int parent = -1;
+    uint32_t priority = 0;
+    // Aggregates over the subtree rooted here: number of nodes, number of
+    // enter tokens, sum of +1 (enter) / -1 (exit), and the smallest such sum
+    // over any non-empty prefix of its tokens.
+    int count = 1;
+    int enters = 0;
+    int balance = 0;
+    int min_balance = 0;
+  };
+
+  // Aggregates over every node of the tour up to and including a node.
+  struct Prefix {
+    int tokens = 0;
+    int enters = 0;
+    int balance = 0;
+  };
+
+  static int Enter(BodyId body) { return 2 * body; }
+  static int Exit(BodyId body) { return 2 * body + 1; }
+
+  BodyId Id(absl::string_view body) const;
+  // Returns the id of |body|, adding it as an unattached root if it's new.
+  BodyId FindOrAdd(absl::string_view body);
+
+  int Depth(BodyId body) const;
+  int SubtreeSize(BodyId body) const;
+  // True if |body| is |ancestor| or orbits it directly or indirectly.
+  bool IsWithin(BodyId body, BodyId ancestor) const;
+
+  // Moves the span of |body| so it directly orbits |center|.
+  void Attach(BodyId body, BodyId center);
+
+  // Treap primitives.
+  int Count(int node) const { return node == -1 ? 0 : nodes_[node].count; }
+  int Enters(int node) const { return node == -1 ? 0 : nodes_[node].enters; }
+  int Balance(int node) const {
+    return node == -1 ? 0 : nodes_[node].balance;
+  }
+  // Smallest running balance of the whole tour, starting from |offset| before
+  // |node|'s subtree, at any of the subtree's tokens in [|begin|, |end|).
+  int MinBalance(int node, int begin, int end, int offset) const;
+  void Update(int node);
+  int Merge(int left, int right);
+  // Splits |node| into its first |count| tokens and the rest.
+  std::pair<int, int> Split(int node, int count);
+  Prefix PrefixThrough(int node) const;
+
+  absl::flat_hash_map<std::string, BodyId> ids_;
+  std::vector<BodyId> free_ids_;
+  std::vector<Node> nodes_;
+  // Root of the treap holding the tour of the whole forest.
+  int root_ = -1;
+  int64_t total_orbits_ = 0;
+  std::minstd_rand rng_;
+};
+
+#endif  // DAY6_DYNAMIC_ORBITS_H_
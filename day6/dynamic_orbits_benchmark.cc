@@ -0,0 +1,141 @@
+// Compares keeping the part 1 total current under a stream of edits by
+// rebuilding an OrbitTree after every edit against updating DynamicOrbits.
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "day6/dynamic_orbits.h"
+#include "day6/orbit_tree.h"
+
+namespace {
+
+enum EditKind { kAdd, kReparent, kRemove };
+
+struct Edit {
+  EditKind kind;
+  int body;
+  // The new center for kAdd and kReparent.
+  int center;
+};
+
+// A random orbit map plus a random stream of edits to it. Bodies are numbered
+// so that every body's center has a lower number than the body itself, which
+// keeps every edit free of cycles.
+struct Workload {
+  std::vector<std::string> names;
+  // Center of each initial body, -1 for the root.
+  std::vector<int> centers;
+  std::vector<Edit> edits;
+};
+
+Workload MakeWorkload(int bodies, int edits) {
+  std::mt19937 rng(bodies);
+  Workload workload;
+  for (int i = 0; i < bodies + edits; ++i) {
+    workload.names.push_back(absl::StrCat("B", i));
+  }
+  workload.centers.push_back(-1);
+  for (int i = 1; i < bodies; ++i) {
+    workload.centers.push_back(rng() % i);
+  }
+
+  std::vector<int> alive(bodies);
+  std::iota(alive.begin(), alive.end(), 0);
+  int next_body = bodies;
+  for (int i = 0; i < edits; ++i) {
+    switch (rng() % 4) {
+      case 0:
+        workload.edits.push_back(
+            {kAdd, next_body++, alive[rng() % alive.size()]});
+        alive.push_back(workload.edits.back().body);
+        break;
+      case 1: {
+        // Never remove the root, so there is always one tree.
+        int index = 1 + rng() % (alive.size() - 1);
+        workload.edits.push_back({kRemove, alive[index], -1});
+        alive.erase(alive.begin() + index);
+        break;
+      }
+      default: {
+        int a = alive[rng() % alive.size()];
+        int b = alive[rng() % alive.size()];
+        if (a == b) break;
+        workload.edits.push_back({kReparent, std::max(a, b), std::min(a, b)});
+        break;
+      }
+    }
+  }
+  return workload;
+}
+
+void BM_FullRebuild(benchmark::State& state) {
+  Workload workload = MakeWorkload(state.range(0), state.range(1));
+  for (auto _ : state) {
+    // -2 marks a body that doesn't exist (yet, or any more).
+    std::vector<int> centers(workload.names.size(), -2);
+    std::copy(workload.centers.begin(), workload.centers.end(),
+              centers.begin());
+    for (const Edit& edit : workload.edits) {
+      if (edit.kind == kRemove) {
+        for (int& center : centers) {
+          if (center == edit.body) center = centers[edit.body];
+        }
+        centers[edit.body] = -2;
+      } else {
+        centers[edit.body] = edit.center;
+      }
+      std::vector<OrbitT> orbits;
+      for (int body = 0; body < centers.size(); ++body) {
+        if (centers[body] < 0) continue;
+        orbits.push_back(
+            {workload.names[centers[body]], workload.names[body]});
+      }
+      OrbitTree tree(InternOrbits(orbits));
+      benchmark::DoNotOptimize(tree.TotalOrbits());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * workload.edits.size());
+}
+
+void BM_Incremental(benchmark::State& state) {
+  Workload workload = MakeWorkload(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    DynamicOrbits orbits;
+    for (int body = 1; body < workload.centers.size(); ++body) {
+      orbits.AddOrbit(workload.names[workload.centers[body]],
+                      workload.names[body]);
+    }
+    state.ResumeTiming();
+    for (const Edit& edit : workload.edits) {
+      const std::string& body = workload.names[edit.body];
+      switch (edit.kind) {
+        case kAdd:
+          orbits.AddOrbit(workload.names[edit.center], body);
+          break;
+        case kReparent:
+          orbits.Reparent(body, workload.names[edit.center]);
+          break;
+        case kRemove:
+          orbits.Remove(body);
+          break;
+      }
+      benchmark::DoNotOptimize(orbits.TotalOrbits());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * workload.edits.size());
+}
+
+// Arguments are the number of bodies and the number of edits.
+BENCHMARK(BM_FullRebuild)->Args({1 << 10, 256})->Args({1 << 14, 256});
+BENCHMARK(BM_Incremental)
+    ->Args({1 << 10, 256})
+    ->Args({1 << 14, 256})
+    ->Args({1 << 20, 1 << 16});
+
+}  // namespace
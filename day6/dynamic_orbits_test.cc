@@ -0,0 +1,107 @@
+#include "day6/dynamic_orbits.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "day6/orbit_tree.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The orbits DynamicOrbits should hold: each body's center, "" for COM.
+typedef absl::flat_hash_map<std::string, std::string> CentersT;
+
+// True if |body| is |ancestor| or orbits it directly or indirectly.
+bool IsWithin(const CentersT& centers, std::string body,
+              const std::string& ancestor) {
+  for (; !body.empty(); body = centers.at(body)) {
+    if (body == ancestor) return true;
+  }
+  return false;
+}
+
+// Rebuilds an OrbitTree from |centers| and expects |dynamic| to agree with it
+// on the total, on every body's depth and on the transfers between every
+// pair of bodies that orbit something.
+void ExpectSameAsRebuilt(const DynamicOrbits& dynamic,
+                         const CentersT& centers) {
+  std::vector<OrbitT> orbits;
+  for (const auto& [body, center] : centers) {
+    if (!center.empty()) orbits.push_back({center, body});
+  }
+  OrbitTree tree(InternOrbits(orbits));
+  ASSERT_EQ(dynamic.size(), centers.size());
+  EXPECT_EQ(dynamic.TotalOrbits(), tree.TotalOrbits());
+  for (const auto& [body, center] : centers) {
+    BodyId id = *tree.Find(body);
+    EXPECT_EQ(dynamic.Depth(body), tree.depth(id)) << body;
+    if (center.empty()) continue;
+    for (const auto& [other, other_center] : centers) {
+      if (other_center.empty()) continue;
+      EXPECT_EQ(dynamic.Transfers(body, other),
+                tree.Transfers(id, *tree.Find(other)))
+          << body << " to " << other;
+    }
+  }
+}
+
+TEST(DynamicOrbitsTest, MatchesRebuiltTreeAfterEveryEdit) {
+  for (uint32_t seed : {1, 2, 3, 4, 5}) {
+    SCOPED_TRACE(testing::Message() << "Seed " << seed);
+    std::mt19937 rng(seed);
+    DynamicOrbits dynamic;
+    CentersT centers = {{"COM", ""}};
+    std::vector<std::string> bodies = {"COM"};
+    int next_name = 0;
+    auto random_body = [&]() { return bodies[rng() % bodies.size()]; };
+
+    for (int step = 0; step < 200; ++step) {
+      // Half adds, so the map grows to a few dozen bodies; never remove or
+      // move while too small for it to matter.
+      int choice = bodies.size() < 4 ? 0 : rng() % 4;
+      if (choice <= 1) {
+        std::string body = absl::StrCat("B", next_name++);
+        std::string center = random_body();
+        dynamic.AddOrbit(center, body);
+        centers[body] = center;
+        bodies.push_back(body);
+      } else if (choice == 2) {
+        // Never COM, so there is always one tree.
+        int index = 1 + rng() % (bodies.size() - 1);
+        std::string body = bodies[index];
+        dynamic.Remove(body);
+        for (auto& [other, center] : centers) {
+          if (center == body) center = centers[body];
+        }
+        centers.erase(body);
+        bodies.erase(bodies.begin() + index);
+      } else {
+        std::string body = bodies[1 + rng() % (bodies.size() - 1)];
+        std::string center = random_body();
+        if (IsWithin(centers, center, body)) continue;
+        dynamic.Reparent(body, center);
+        centers[body] = center;
+      }
+      ExpectSameAsRebuilt(dynamic, centers);
+      if (HasFailure()) return;
+    }
+  }
+}
+
+TEST(DynamicOrbitsTest, AttachesARootWithItsSatellites) {
+  DynamicOrbits dynamic;
+  // B's subtree is built before B orbits anything.
+  dynamic.AddOrbit("B", "C");
+  dynamic.AddOrbit("C", "D");
+  dynamic.AddOrbit("COM", "A");
+  dynamic.AddOrbit("A", "B");
+  CentersT centers = {
+      {"COM", ""}, {"A", "COM"}, {"B", "A"}, {"C", "B"}, {"D", "C"}};
+  ExpectSameAsRebuilt(dynamic, centers);
+  EXPECT_EQ(dynamic.SubtreeSize("B"), 3);
+}
+
+}  // namespace
@@ -0,0 +1,118 @@
+#include "day6/orbit_parser.h"
+
+#include <cstring>
+
+#include "glog/logging.h"
+
+namespace {
+
+// One piece of the text, parsed and interned on its own.
+struct Chunk {
+  absl::string_view text;
+  absl::flat_hash_map<absl::string_view, BodyId> ids;
+  std::vector<absl::string_view> names;
+  // Each orbit as (center, satellite), in ids local to this chunk.
+  std::vector<std::pair<BodyId, BodyId>> orbits;
+};
+
+void ParseChunk(Chunk& chunk) {
+  auto intern = [&](absl::string_view name) {
+    auto [iter, inserted] = chunk.ids.try_emplace(name, chunk.names.size());
+    if (inserted) chunk.names.push_back(name);
+    return iter->second;
+  };
+  const char* cursor = chunk.text.data();
+  const char* end = cursor + chunk.text.size();
+  while (cursor < end) {
+    auto* line_end =
+        static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+    if (line_end == nullptr) line_end = end;
+    if (line_end != cursor) {
+      auto* separator =
+          static_cast<const char*>(memchr(cursor, ')', line_end - cursor));
+      CHECK(separator) << "Not an orbit: "
+                       << absl::string_view(cursor, line_end - cursor);
+      BodyId center = intern(absl::string_view(cursor, separator - cursor));
+      BodyId satellite = intern(
+          absl::string_view(separator + 1, line_end - separator - 1));
+      chunk.orbits.push_back({center, satellite});
+    }
+    cursor = line_end + 1;
+  }
+}
+
+// Cuts |text| into (at most) |chunks| roughly equal pieces, moving each cut
+// forward to just past the next newline.
+std::vector<Chunk> CutChunks(absl::string_view text, int chunks) {
+  std::vector<Chunk> pieces;
+  size_t start = 0;
+  for (int i = 1; i <= chunks && start < text.size(); ++i) {
+    size_t cut = text.size() * i / chunks;
+    if (cut < start) cut = start;
+    if (i < chunks) {
+      cut = text.find('\n', cut);
+      cut = cut == absl::string_view::npos ? text.size() : cut + 1;
+    }
+    pieces.emplace_back();
+    pieces.back().text = text.substr(start, cut - start);
+    start = cut;
+  }
+  return pieces;
+}
+
+// Merges parsed pieces, in order.
+ParsedOrbits MergeChunks(std::vector<Chunk>& pieces) {
+  ParsedOrbits parsed;
+  // A lone piece's ids are already the final ones.
+  if (pieces.size() == 1) {
+    parsed.ids = std::move(pieces[0].ids);
+    parsed.names = std::move(pieces[0].names);
+    parsed.centers.assign(parsed.names.size(), -1);
+    for (auto [center, satellite] : pieces[0].orbits) {
+      CHECK_EQ(parsed.centers[satellite], -1)
+          << "Already known: " << parsed.names[satellite];
+      parsed.centers[satellite] = center;
+    }
+    return parsed;
+  }
+  // Each chunk has already collapsed its repeated names, so only its
+  // distinct names go through the shared table.
+  std::vector<BodyId> global_ids;
+  for (const Chunk& chunk : pieces) {
+    global_ids.clear();
+    for (absl::string_view name : chunk.names) {
+      auto [iter, inserted] = parsed.ids.try_emplace(name, parsed.names.size());
+      if (inserted) {
+        parsed.names.push_back(name);
+        parsed.centers.push_back(-1);
+      }
+      global_ids.push_back(iter->second);
+    }
+    for (auto [center, satellite] : chunk.orbits) {
+      BodyId child = global_ids[satellite];
+      CHECK_EQ(parsed.centers[child], -1)
+          << "Already known: " << parsed.names[child];
+      parsed.centers[child] = global_ids[center];
+    }
+  }
+  return parsed;
+}
+
+}  // namespace
+
+ParsedOrbits ParseOrbits(absl::string_view text) {
+  std::vector<Chunk> pieces = CutChunks(text, 1);
+  for (Chunk& piece : pieces) ParseChunk(piece);
+  return MergeChunks(pieces);
+}
+
+ParsedOrbits ParseOrbits(absl::string_view text, ThreadPool& pool) {
+  std::vector<Chunk> pieces = CutChunks(text, pool.size());
+  pool.ParallelFor(pieces.size(), 1,
+                   [&](int worker, int64_t begin, int64_t end) {
+                     for (int64_t i = begin; i < end; ++i) {
+                       ParseChunk(pieces[i]);
+                     }
+                   });
+  return MergeChunks(pieces);
+}
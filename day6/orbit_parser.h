@@ -0,0 +1,17 @@
+#ifndef DAY6_ORBIT_PARSER_H_
+#define DAY6_ORBIT_PARSER_H_
+
+#include "absl/strings/string_view.h"
+#include "common/thread_pool.h"
+#include "day6/orbit_tree.h"
+
+// Parses "A)B" lines without copying any names: they are views into |text|,
+// which must outlive the result.
+ParsedOrbits ParseOrbits(absl::string_view text);
+
+// Same as above, but the text is split on line boundaries into (at most) one
+// piece per worker of |pool|, and the pieces are parsed and interned in
+// parallel before being merged.
+ParsedOrbits ParseOrbits(absl::string_view text, ThreadPool& pool);
+
+#endif  // DAY6_ORBIT_PARSER_H_
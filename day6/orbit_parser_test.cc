@@ -0,0 +1,91 @@
+#include "day6/orbit_parser.h"
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "common/thread_pool.h"
+#include "day6/orbit_tree.h"
+#include "gen/generators.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The example from the puzzle, 54 orbits in all and 4 transfers from YOU to
+// SAN.
+constexpr absl::string_view kExample =
+    "COM)B\nB)C\nC)D\nD)E\nE)F\nB)G\nG)H\nD)I\nE)J\nJ)K\nK)L\nK)YOU\nI)SAN\n";
+
+// Each body's center by name, "" for a body that orbits nothing. Also expects
+// every name to be a view into |text|.
+absl::flat_hash_map<absl::string_view, absl::string_view> CentersByName(
+    const ParsedOrbits& parsed, absl::string_view text) {
+  absl::flat_hash_map<absl::string_view, absl::string_view> centers;
+  EXPECT_EQ(parsed.ids.size(), parsed.names.size());
+  EXPECT_EQ(parsed.centers.size(), parsed.names.size());
+  for (BodyId body = 0; body < parsed.names.size(); ++body) {
+    absl::string_view name = parsed.names[body];
+    EXPECT_EQ(parsed.ids.at(name), body) << name;
+    EXPECT_TRUE(name.data() >= text.data() &&
+                name.data() + name.size() <= text.data() + text.size())
+        << name << " was copied";
+    BodyId center = parsed.centers[body];
+    centers[name] = center == -1 ? "" : parsed.names[center];
+  }
+  return centers;
+}
+
+// Expects |text| to parse to the same orbits serially and with pools of
+// several sizes, so the pieces are cut at many different places, and the
+// tree built from each to give |total_orbits| and |transfers|.
+void ExpectSameOnEveryPool(absl::string_view text, int64_t total_orbits,
+                           int transfers) {
+  auto expected = CentersByName(ParseOrbits(text), text);
+  {
+    OrbitTree tree(ParseOrbits(text));
+    EXPECT_EQ(tree.TotalOrbits(), total_orbits);
+    EXPECT_EQ(tree.Transfers(*tree.Find("YOU"), *tree.Find("SAN")), transfers);
+  }
+  for (int threads = 1; threads <= 9; ++threads) {
+    SCOPED_TRACE(testing::Message() << threads << " threads");
+    ThreadPool pool(threads);
+    EXPECT_EQ(CentersByName(ParseOrbits(text, pool), text), expected);
+    OrbitTree tree(ParseOrbits(text, pool));
+    EXPECT_EQ(tree.TotalOrbits(), total_orbits);
+    EXPECT_EQ(tree.Transfers(*tree.Find("YOU"), *tree.Find("SAN")), transfers);
+  }
+}
+
+TEST(ParseOrbitsTest, SplitsMidLine) {
+  ExpectSameOnEveryPool(kExample, 54, 4);
+}
+
+TEST(ParseOrbitsTest, ParsesWithoutATrailingNewline) {
+  absl::string_view text = kExample;
+  text.remove_suffix(1);
+  ExpectSameOnEveryPool(text, 54, 4);
+  // The last line is the only one that can be cut short.
+  ParsedOrbits parsed = ParseOrbits(text);
+  EXPECT_EQ(parsed.names[parsed.centers[parsed.ids.at("SAN")]], "I");
+}
+
+TEST(ParseOrbitsTest, SkipsBlankLines) {
+  std::string text = "\n\nCOM)A\n\nA)YOU\n\n\nA)SAN";
+  ExpectSameOnEveryPool(text, 5, 0);
+}
+
+TEST(ParseOrbitsTest, MatchesSerialOnGeneratedMaps) {
+  for (uint64_t seed : {1, 2, 3}) {
+    SCOPED_TRACE(testing::Message() << "Seed " << seed);
+    std::string text = GenerateOrbits(3000, 40, 3, seed);
+    OrbitTree tree(ParseOrbits(text));
+    int64_t total_orbits = tree.TotalOrbits();
+    int transfers = tree.Transfers(*tree.Find("YOU"), *tree.Find("SAN"));
+    ExpectSameOnEveryPool(text, total_orbits, transfers);
+    // Again with the final newline dropped.
+    text.pop_back();
+    ExpectSameOnEveryPool(text, total_orbits, transfers);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,145 @@
+#include "day6/orbit_tree.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "glog/logging.h"
+
+namespace {
+
+// floor(log2(n)) for n > 0.
+int Log2(unsigned int n) { return 31 - __builtin_clz(n); }
+
+}  // namespace
+
+ParsedOrbits InternOrbits(const std::vector<OrbitT>& orbits) {
+  ParsedOrbits parsed;
+  // Assign every body an id, in order of first appearance.
+  auto intern = [&](absl::string_view name) {
+    auto [iter, inserted] = parsed.ids.try_emplace(name, parsed.names.size());
+    if (inserted) {
+      parsed.names.push_back(name);
+      parsed.centers.push_back(-1);
+    }
+    return iter->second;
+  };
+  for (const auto& [center, satellite] : orbits) {
+    BodyId parent = intern(center);
+    BodyId child = intern(satellite);
+    CHECK_EQ(parsed.centers[child], -1) << "Already known: " << satellite;
+    parsed.centers[child] = parent;
+  }
+  return parsed;
+}
+
+OrbitTree::OrbitTree(ParsedOrbits orbits)
+    : ids_(std::move(orbits.ids)),
+      names_(std::move(orbits.names)),
+      parent_(std::move(orbits.centers)) {
+  const int n = names_.size();
+  CHECK_GT(n, 0);
+
+  // Children of each body, as offsets into a single array.
+  std::vector<int> child_offsets(n + 1, 0);
+  BodyId root = -1;
+  for (BodyId body = 0; body < n; ++body) {
+    if (parent_[body] == -1) {
+      CHECK_EQ(root, -1) << "Multiple roots: " << names_[root] << " and "
+                         << names_[body];
+      root = body;
+    } else {
+      ++child_offsets[parent_[body] + 1];
+    }
+  }
+  CHECK_NE(root, -1) << "No root; the orbits contain a cycle.";
+  std::partial_sum(child_offsets.begin(), child_offsets.end(),
+                   child_offsets.begin());
+  std::vector<BodyId> children(n - 1);
+  {
+    std::vector<int> cursor(child_offsets.begin(), child_offsets.end() - 1);
+    for (BodyId body = 0; body < n; ++body) {
+      if (parent_[body] != -1) children[cursor[parent_[body]]++] = body;
+    }
+  }
+
+  // Walk the tree depth-first with an explicit stack (orbit chains can be far
+  // deeper than the call stack allows), recording the Euler tour.
+  depth_.assign(n, 0);
+  first_visit_.assign(n, -1);
+  tour_.reserve(2 * n - 1);
+  // Each entry is a body and the index of the next child to visit.
+  std::vector<std::pair<BodyId, int>> stack = {{root, child_offsets[root]}};
+  first_visit_[root] = 0;
+  tour_.push_back(root);
+  while (!stack.empty()) {
+    auto& [body, next_child] = stack.back();
+    if (next_child == child_offsets[body + 1]) {
+      stack.pop_back();
+      if (!stack.empty()) tour_.push_back(stack.back().first);
+      continue;
+    }
+    BodyId child = children[next_child++];
+    depth_[child] = depth_[body] + 1;
+    first_visit_[child] = tour_.size();
+    tour_.push_back(child);
+    stack.push_back({child, child_offsets[child]});
+  }
+  // Anything unvisited is on a cycle that isn't connected to the root.
+  CHECK_EQ(tour_.size(), 2 * n - 1) << "Orbits are not a single tree.";
+
+  // Build the sparse table; each level doubles the span of the one before.
+  sparse_.push_back(tour_);
+  for (int k = 1; (1 << k) <= tour_.size(); ++k) {
+    const auto& previous = sparse_[k - 1];
+    std::vector<BodyId> level(tour_.size() - (1 << k) + 1);
+    for (int i = 0; i < level.size(); ++i) {
+      level[i] = Shallower(previous[i], previous[i + (1 << (k - 1))]);
+    }
+    sparse_.push_back(std::move(level));
+  }
+}
+
+absl::optional<BodyId> OrbitTree::Find(absl::string_view name) const {
+  auto iter = ids_.find(name);
+  if (iter == ids_.end()) return absl::nullopt;
+  return iter->second;
+}
+
+int64_t OrbitTree::TotalOrbits() const {
+  return std::accumulate(depth_.begin(), depth_.end(), int64_t{0});
+}
+
+BodyId OrbitTree::Lca(BodyId a, BodyId b) const {
+  int left = first_visit_[a];
+  int right = first_visit_[b];
+  if (left > right) std::swap(left, right);
+  // Two (possibly overlapping) power-of-two spans cover [left, right].
+  int k = Log2(right - left + 1);
+  return Shallower(sparse_[k][left], sparse_[k][right - (1 << k) + 1]);
+}
+
+int OrbitTree::Distance(BodyId a, BodyId b) const {
+  return depth_[a] + depth_[b] - 2 * depth_[Lca(a, b)];
+}
+
+int OrbitTree::Transfers(BodyId from, BodyId to) const {
+  CHECK_NE(parent_[from], -1) << names_[from] << " orbits nothing.";
+  CHECK_NE(parent_[to], -1) << names_[to] << " orbits nothing.";
+  return Distance(parent_[from], parent_[to]);
+}
+
+std::vector<int> OrbitTree::Transfers(
+    absl::Span<const std::pair<BodyId, BodyId>> queries,
+    ThreadPool& pool) const {
+  std::vector<int> results(queries.size());
+  // Each query is a few loads, so blocks are large enough to outweigh
+  // scheduling them.
+  pool.ParallelFor(queries.size(), 4096,
+                   [&](int worker, int64_t begin, int64_t end) {
+                     for (int64_t i = begin; i < end; ++i) {
+                       results[i] =
+                           Transfers(queries[i].first, queries[i].second);
+                     }
+                   });
+  return results;
+}
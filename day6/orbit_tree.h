@@ -0,0 +1,95 @@
+#ifndef DAY6_ORBIT_TREE_H_
+#define DAY6_ORBIT_TREE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+#include "common/thread_pool.h"
+
+// Index of a body within an OrbitTree.
+typedef int BodyId;
+
+// A single "A)B" orbit from the input: B orbits A.
+typedef std::pair<std::string, std::string> OrbitT;
+
+// Orbits with every body interned to a dense id. Names are views into the
+// original text, which must outlive this (and any OrbitTree built from it).
+struct ParsedOrbits {
+  absl::flat_hash_map<absl::string_view, BodyId> ids;
+  std::vector<absl::string_view> names;
+  // The center each body orbits, or -1 if it orbits nothing.
+  std::vector<BodyId> centers;
+};
+
+// Interns a list of orbits. The names are views into |orbits|, so it must
+// outlive the result and any OrbitTree built from it.
+ParsedOrbits InternOrbits(const std::vector<OrbitT>& orbits);
+
+// The orbit map as a rooted tree, preprocessed for lowest-common-ancestor
+// queries. Preprocessing records an Euler tour of the tree and builds a sparse
+// table over it, so any LCA (and so any distance) is answered in O(1) after
+// O(n log n) setup.
+class OrbitTree {
+ public:
+  // Builds the tree from interned orbits. Exactly one body (the root) must
+  // orbit nothing.
+  explicit OrbitTree(ParsedOrbits orbits);
+
+  // Number of bodies in the tree.
+  int size() const { return parent_.size(); }
+
+  // Finds a body by name.
+  absl::optional<BodyId> Find(absl::string_view name) const;
+  absl::string_view name(BodyId body) const { return names_[body]; }
+
+  // The body that orbits nothing.
+  BodyId root() const { return tour_[0]; }
+  // The body |body| orbits directly, or -1 for the root.
+  BodyId parent(BodyId body) const { return parent_[body]; }
+  // Number of direct and indirect orbits of |body|.
+  int depth(BodyId body) const { return depth_[body]; }
+
+  // Sum of direct and indirect orbits over every body (part 1).
+  int64_t TotalOrbits() const;
+
+  // Lowest common ancestor of |a| and |b|.
+  BodyId Lca(BodyId a, BodyId b) const;
+
+  // Number of orbits between |a| and |b|.
+  int Distance(BodyId a, BodyId b) const;
+
+  // Number of orbital transfers to move from the body |from| is orbiting to
+  // the body |to| is orbiting (part 2).
+  int Transfers(BodyId from, BodyId to) const;
+
+  // Answers a batch of Transfers queries, spread across |pool|'s workers.
+  std::vector<int> Transfers(
+      absl::Span<const std::pair<BodyId, BodyId>> queries,
+      ThreadPool& pool) const;
+
+ private:
+  // Returns whichever of |a| and |b| is shallower.
+  BodyId Shallower(BodyId a, BodyId b) const {
+    return depth_[a] <= depth_[b] ? a : b;
+  }
+
+  absl::flat_hash_map<absl::string_view, BodyId> ids_;
+  std::vector<absl::string_view> names_;
+  std::vector<BodyId> parent_;
+  std::vector<int> depth_;
+
+  // Euler tour of the tree: every body is recorded on the way down and again
+  // after returning from each of its children.
+  std::vector<BodyId> tour_;
+  // Index of the first visit to each body in |tour_|.
+  std::vector<int> first_visit_;
+  // sparse_[k][i] is the shallowest body in tour_[i, i + 2^k).
+  std::vector<std::vector<BodyId>> sparse_;
+};
+
+#endif  // DAY6_ORBIT_TREE_H_
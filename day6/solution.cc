@@ -0,0 +1,38 @@
+#include "day6/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "common/thread_pool.h"
+#include "day6/orbit_parser.h"
+#include "glog/logging.h"
+
+namespace day6 {
+namespace {
+
+// Inputs smaller than this (the real one is 14 KiB) are too little work to be
+// worth handing out to other threads.
+constexpr size_t kParallelParseBytes = 1 << 18;
+
+}  // namespace
+
+// Large inputs parse on the pool this is called from, if any, so a driver
+// running many days shares its threads; otherwise on the process's shared
+// pool.
+Input Parse(absl::string_view text) {
+  if (text.size() < kParallelParseBytes) return OrbitTree(ParseOrbits(text));
+  return OrbitTree(ParseOrbits(text, ThreadPool::Default()));
+}
+
+std::string Part1(const Input& tree) {
+  // Every body's depth is the number of direct and indirect orbits.
+  return absl::StrCat(tree.TotalOrbits());
+}
+
+std::string Part2(const Input& tree) {
+  // Go from the object YOU are orbiting to the object SAN is orbiting.
+  auto you = tree.Find("YOU");
+  auto san = tree.Find("SAN");
+  CHECK(you && san);
+  return absl::StrCat(tree.Transfers(*you, *san));
+}
+
+}  // namespace day6
@@ -0,0 +1,25 @@
+#ifndef DAY6_SOLUTION_H_
+#define DAY6_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "day6/orbit_tree.h"
+
+namespace day6 {
+
+// The orbit map. Body names are views into the parsed text.
+typedef OrbitTree Input;
+
+Input Parse(absl::string_view text);
+// Total number of direct and indirect orbits.
+std::string Part1(const Input& tree);
+// Orbital transfers from the body YOU orbit to the body SAN orbits.
+std::string Part2(const Input& tree);
+
+inline const Solution<Input> kSolution = {"day6", Parse, Part1, Part2};
+
+}  // namespace day6
+
+#endif  // DAY6_SOLUTION_H_
@@ -0,0 +1,18 @@
+#include <cmath>
+
+#include "common/day_benchmark.h"
+#include "day7/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are the number of iterations of a doubly nested loop, which ignores
+// its inputs and outputs its count once. Each part runs it 600 times.
+const bool registered = RegisterSolutionBenchmarks(
+    day7::kSolution, "day7/input.txt",
+    [](int64_t size) {
+      return GenerateIntcodeLoops(2, std::llround(std::sqrt(size)));
+    },
+    {1 << 6, 1 << 10, 1 << 14});
+
+}  // namespace
@@ -0,0 +1,25 @@
+#ifndef DAY7_SOLUTION_H_
+#define DAY7_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "intcode/intcode.h"
+
+namespace day7 {
+
+// The amplifier controller software.
+typedef Memory Input;
+
+Input Parse(absl::string_view text);
+// Highest thruster signal from amplifiers in series.
+std::string Part1(const Input& memory);
+// Highest thruster signal from amplifiers in a feedback loop.
+std::string Part2(const Input& memory);
+
+inline const Solution<Input> kSolution = {"day7", Parse, Part1, Part2};
+
+}  // namespace day7
+
+#endif  // DAY7_SOLUTION_H_
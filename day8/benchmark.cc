@@ -0,0 +1,26 @@
+#include "absl/strings/str_cat.h"
+#include "common/day_benchmark.h"
+#include "day8/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+bool Register() {
+  // The puzzle's 25 x 6 layers: the real input, then generated stacks of
+  // |size| layers, nine tenths of each transparent.
+  RegisterSolutionBenchmarks(
+      day8::MakeSolution(25, 6), "day8/input.txt",
+      [](int64_t size) { return GenerateImage(25, 6, size, 0.9, size); },
+      {1 << 8, 1 << 14, 1 << 20});
+  // Square layers of |side| pixels a side, 64 layers deep.
+  for (int side : {64, 512, 2048}) {
+    RegisterGeneratedBenchmarks(
+        day8::MakeSolution(side, side), absl::StrCat(side, "x", side),
+        [side] { return GenerateImage(side, side, 64, 0.9, side); });
+  }
+  return true;
+}
+
+const bool registered = Register();
+
+}  // namespace
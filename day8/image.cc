@@ -0,0 +1,249 @@
+#include "day8/image.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DAY8_HAVE_SIMD_KERNELS 1
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "absl/strings/ascii.h"
+#include "glog/logging.h"
+
+namespace {
+
+// Pixels per tile when compositing in parallel. Small enough that a tile of
+// every layer group stays in cache, big enough to amortize scheduling.
+constexpr size_t kTileSize = 16 * 1024;
+
+bool AnyTransparent(const char* pixels, size_t size) {
+  return memchr(pixels, kTransparent, size) != nullptr;
+}
+
+#ifdef DAY8_HAVE_SIMD_KERNELS
+
+// The kernels below each handle a prefix of whole vectors and return its
+// length, leaving the rest to the scalar loops. They compare a whole vector
+// of pixels at once and count or blend by the comparison's byte mask.
+
+__attribute__((target("avx2"))) size_t CountDigitsAvx2(const char* pixels,
+                                                       size_t size,
+                                                       DigitCounts* counts) {
+  const __m256i zero = _mm256_set1_epi8(kBlack);
+  const __m256i one = _mm256_set1_epi8(kWhite);
+  const __m256i two = _mm256_set1_epi8(kTransparent);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+    counts->zeros += __builtin_popcount(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+    counts->ones += __builtin_popcount(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, one)));
+    counts->twos += __builtin_popcount(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, two)));
+  }
+  return i;
+}
+
+// SSE2 is part of x86-64, so this needs no check.
+size_t CountDigitsSse2(const char* pixels, size_t size, DigitCounts* counts) {
+  const __m128i zero = _mm_set1_epi8(kBlack);
+  const __m128i one = _mm_set1_epi8(kWhite);
+  const __m128i two = _mm_set1_epi8(kTransparent);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+    counts->zeros +=
+        __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+    counts->ones +=
+        __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, one)));
+    counts->twos +=
+        __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, two)));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t CompositeUnderAvx2(char* image,
+                                                          const char* layer,
+                                                          size_t size) {
+  const __m256i transparent = _mm256_set1_epi8(kTransparent);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    auto* out = reinterpret_cast<__m256i*>(image + i);
+    __m256i front = _mm256_loadu_si256(out);
+    __m256i back =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layer + i));
+    __m256i mask = _mm256_cmpeq_epi8(front, transparent);
+    _mm256_storeu_si256(out, _mm256_blendv_epi8(front, back, mask));
+  }
+  return i;
+}
+
+size_t CompositeUnderSse2(char* image, const char* layer, size_t size) {
+  const __m128i transparent = _mm_set1_epi8(kTransparent);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    auto* out = reinterpret_cast<__m128i*>(image + i);
+    __m128i front = _mm_loadu_si128(out);
+    __m128i back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layer + i));
+    __m128i mask = _mm_cmpeq_epi8(front, transparent);
+    _mm_storeu_si128(out, _mm_or_si128(_mm_and_si128(mask, back),
+                                       _mm_andnot_si128(mask, front)));
+  }
+  return i;
+}
+
+bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+#endif
+
+}  // namespace
+
+LayeredImage::LayeredImage(std::string data, int width, int height)
+    : data_(std::move(data)), width_(width), height_(height) {
+  CHECK_GT(width_, 0);
+  CHECK_GT(height_, 0);
+  while (!data_.empty() && absl::ascii_isspace(data_.back())) data_.pop_back();
+  CHECK_EQ(data_.size() % layer_size(), 0)
+      << "Not a whole number of " << width_ << "x" << height_ << " layers.";
+}
+
+DigitCounts CountDigits(absl::string_view layer) {
+  DigitCounts counts;
+  const char* pixels = layer.data();
+  size_t size = layer.size();
+  size_t i = 0;
+#ifdef DAY8_HAVE_SIMD_KERNELS
+  i = HasAvx2() ? CountDigitsAvx2(pixels, size, &counts)
+                : CountDigitsSse2(pixels, size, &counts);
+#endif
+  for (; i < size; ++i) {
+    counts.zeros += pixels[i] == kBlack;
+    counts.ones += pixels[i] == kWhite;
+    counts.twos += pixels[i] == kTransparent;
+  }
+  return counts;
+}
+
+void CompositeUnder(char* image, const char* layer, size_t size) {
+  size_t i = 0;
+#ifdef DAY8_HAVE_SIMD_KERNELS
+  i = HasAvx2() ? CompositeUnderAvx2(image, layer, size)
+                : CompositeUnderSse2(image, layer, size);
+#endif
+  for (; i < size; ++i) {
+    if (image[i] == kTransparent) image[i] = layer[i];
+  }
+}
+
+std::string Composite(const LayeredImage& image) {
+  std::string pixels(image.layer_size(), kTransparent);
+  for (int i = 0; i < image.layer_count(); ++i) {
+    CompositeUnder(&pixels[0], image.layer(i).data(), pixels.size());
+  }
+  return pixels;
+}
+
+std::string ParallelComposite(const LayeredImage& image, ThreadPool& pool) {
+  const int threads = pool.size();
+  const size_t layer_size = image.layer_size();
+  const int layers = image.layer_count();
+  const int tiles = (layer_size + kTileSize - 1) / kTileSize;
+  // Only split the layer stack when there aren't enough tiles to keep every
+  // thread busy.
+  const int groups =
+      std::max(1, std::min(layers, (2 * threads + tiles - 1) / tiles));
+
+  auto tile_bounds = [&](int tile) {
+    size_t start = tile * kTileSize;
+    return std::make_pair(start, std::min(kTileSize, layer_size - start));
+  };
+
+  std::vector<std::string> partials(groups,
+                                    std::string(layer_size, kTransparent));
+  // Work item |item| is tile item % tiles of group item / tiles.
+  pool.ParallelFor(
+      tiles * groups, 1, [&](int worker, int64_t item, int64_t end) {
+        for (; item < end; ++item) {
+          int group = item / tiles;
+          auto [start, size] = tile_bounds(item % tiles);
+          char* out = &partials[group][start];
+          int first_layer = static_cast<int64_t>(layers) * group / groups;
+          int last_layer = static_cast<int64_t>(layers) * (group + 1) / groups;
+          for (int layer = first_layer; layer < last_layer; ++layer) {
+            CompositeUnder(out, image.layer(layer).data() + start, size);
+            if (!AnyTransparent(out, size)) break;
+          }
+        }
+      });
+
+  // Combine neighbouring groups, doubling the stride each round, so partial
+  // g always covers the layers of groups [g, g + stride).
+  for (int stride = 1; stride < groups; stride *= 2) {
+    std::vector<int> merges;
+    for (int group = 0; group + stride < groups; group += 2 * stride) {
+      for (int tile = 0; tile < tiles; ++tile) {
+        merges.push_back(group * tiles + tile);
+      }
+    }
+    pool.ParallelFor(
+        merges.size(), 1, [&](int worker, int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            int group = merges[i] / tiles;
+            auto [start, size] = tile_bounds(merges[i] % tiles);
+            char* front = &partials[group][start];
+            if (!AnyTransparent(front, size)) continue;
+            CompositeUnder(front, &partials[group + stride][start], size);
+          }
+        });
+  }
+  return std::move(partials[0]);
+}
+
+StreamingDecoder::StreamingDecoder(int width, int height)
+    : buffer_(static_cast<size_t>(width) * height, '\0'),
+      composite_(buffer_.size(), kTransparent) {
+  CHECK_GT(width, 0);
+  CHECK_GT(height, 0);
+}
+
+void StreamingDecoder::Decode(std::istream& in) {
+  while (in.read(&buffer_[0], buffer_.size())) {
+    AddLayer(buffer_);
+  }
+  // Anything left over after the last full layer is just the final newline.
+  for (int i = 0; i < in.gcount(); ++i) {
+    CHECK(absl::ascii_isspace(buffer_[i]))
+        << "Partial layer after " << layer_count_ << " layers.";
+  }
+}
+
+void StreamingDecoder::AddLayer(absl::string_view layer) {
+  CHECK_EQ(layer.size(), composite_.size());
+  DigitCounts counts = CountDigits(layer);
+  if (layer_count_ == 0 || counts.zeros < fewest_zeros_.zeros) {
+    fewest_zeros_ = counts;
+  }
+  CompositeUnder(&composite_[0], layer.data(), composite_.size());
+  ++layer_count_;
+}
+
+const DigitCounts& StreamingDecoder::fewest_zeros() const {
+  CHECK_GT(layer_count_, 0) << "No layers decoded.";
+  return fewest_zeros_;
+}
+
+std::vector<std::string> Render(absl::string_view pixels, int width) {
+  std::vector<std::string> rows;
+  for (size_t start = 0; start < pixels.size(); start += width) {
+    std::string row(pixels.substr(start, width));
+    for (char& c : row) c = c == kWhite ? '*' : ' ';
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
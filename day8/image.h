@@ -0,0 +1,98 @@
+#ifndef DAY8_IMAGE_H_
+#define DAY8_IMAGE_H_
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/thread_pool.h"
+
+// Pixel values, as they appear in the input.
+constexpr char kBlack = '0';
+constexpr char kWhite = '1';
+constexpr char kTransparent = '2';
+
+// How many of each digit a layer has.
+struct DigitCounts {
+  int64_t zeros = 0;
+  int64_t ones = 0;
+  int64_t twos = 0;
+};
+
+// An image in the Space Image Format: every layer of |width| * |height|
+// digits, stored back to back in a single buffer.
+class LayeredImage {
+ public:
+  // |data| must be a whole number of layers; trailing whitespace is ignored.
+  LayeredImage(std::string data, int width, int height);
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  size_t layer_size() const { return static_cast<size_t>(width_) * height_; }
+  int layer_count() const { return data_.size() / layer_size(); }
+
+  absl::string_view layer(int index) const {
+    return absl::string_view(data_).substr(index * layer_size(), layer_size());
+  }
+
+ private:
+  std::string data_;
+  int width_;
+  int height_;
+};
+
+// Counts the 0, 1 and 2 digits in |layer|, 32 pixels at a time on CPUs with
+// AVX2 and 16 on other x86-64 ones.
+DigitCounts CountDigits(absl::string_view layer);
+
+// Composites |layer| beneath |image|: every pixel of |image| that is still
+// transparent takes the value from |layer|. Both must be |size| pixels.
+void CompositeUnder(char* image, const char* layer, size_t size);
+
+// Composites every layer, first in front, into a single layer of digits.
+std::string Composite(const LayeredImage& image);
+
+// Composites the same way as Composite(), but spread across |pool|'s
+// workers. The image is cut into tiles and, when there are fewer tiles than
+// twice the workers, the layer stack into contiguous groups; every (tile,
+// group) pair is composited independently, and then the groups' partial
+// images are combined pairwise in a tree, front group over back. That works
+// because "first non-transparent pixel wins" is associative. A tile stops
+// reading layers once it has no transparent pixels left.
+std::string ParallelComposite(const LayeredImage& image, ThreadPool& pool);
+
+// Decodes an image one layer at a time as it is read, tracking the layer with
+// the fewest zeros and compositing as it goes. Only one layer buffer and the
+// composite are kept, so memory use is the same however many layers there
+// are.
+class StreamingDecoder {
+ public:
+  StreamingDecoder(int width, int height);
+
+  // Reads and decodes layers from |in| (a file or a pipe) until it ends. Any
+  // trailing partial layer must be whitespace.
+  void Decode(std::istream& in);
+
+  // Decodes the next layer, which must be width * height pixels.
+  void AddLayer(absl::string_view layer);
+
+  int layer_count() const { return layer_count_; }
+  // Digit counts of the layer with the fewest zeros. Requires at least one
+  // layer.
+  const DigitCounts& fewest_zeros() const;
+  // Every layer so far composited into one, first in front.
+  const std::string& composite() const { return composite_; }
+
+ private:
+  std::string buffer_;
+  std::string composite_;
+  DigitCounts fewest_zeros_;
+  int layer_count_ = 0;
+};
+
+// Draws a composited layer as rows of text, with white pixels as '*' and
+// everything else as ' '.
+std::vector<std::string> Render(absl::string_view pixels, int width);
+
+#endif  // DAY8_IMAGE_H_
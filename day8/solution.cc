@@ -0,0 +1,64 @@
+#include "day8/solution.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
+#include "common/thread_pool.h"
+#include "glog/logging.h"
+
+namespace day8 {
+namespace {
+
+// Images with fewer pixels than this over all their layers (the real one has
+// 15000) are too little work to be worth handing out to other threads.
+constexpr int64_t kParallelCompositePixels = 1 << 20;
+
+}  // namespace
+
+Input Parse(absl::string_view text, int width, int height) {
+  return LayeredImage(std::string(text), width, height);
+}
+
+std::string Part1(const Input& image) {
+  // Find the layer with the fewest 0 digits.
+  absl::optional<DigitCounts> fewest;
+  for (int i = 0; i < image.layer_count(); ++i) {
+    DigitCounts counts = CountDigits(image.layer(i));
+    if (!fewest || counts.zeros < fewest->zeros) {
+      fewest = counts;
+    }
+  }
+  CHECK(fewest);
+  return Checksum(*fewest);
+}
+
+std::string Part2(const Input& image) {
+  // Collapse into a single image. Large images are composited on the pool
+  // this is called from, if any, so a driver running many days shares its
+  // threads, or else on the process's shared pool.
+  int64_t pixels = static_cast<int64_t>(image.layer_count()) *
+                   image.layer_size();
+  if (pixels < kParallelCompositePixels) {
+    return Picture(Composite(image), image.width());
+  }
+  return Picture(ParallelComposite(image, ThreadPool::Default()),
+                 image.width());
+}
+
+Solution<Input> MakeSolution(int width, int height) {
+  return {"day8",
+          [width, height](absl::string_view text) {
+            return Parse(text, width, height);
+          },
+          Part1, Part2};
+}
+
+std::string Checksum(const DigitCounts& fewest_zeros) {
+  return absl::StrCat(fewest_zeros.ones * fewest_zeros.twos);
+}
+
+std::string Picture(absl::string_view composite, int width) {
+  return absl::StrJoin(Render(composite, width), "\n");
+}
+
+}  // namespace day8
@@ -0,0 +1,33 @@
+#ifndef DAY8_SOLUTION_H_
+#define DAY8_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "day8/image.h"
+
+namespace day8 {
+
+typedef LayeredImage Input;
+
+// Parses an image of |width| x |height| layers. The puzzle's are 25 x 6.
+Input Parse(absl::string_view text, int width, int height);
+// The number of 1 digits times the number of 2 digits in the layer with the
+// fewest 0 digits.
+std::string Part1(const Input& image);
+// The composited image, as rows of text.
+std::string Part2(const Input& image);
+
+// The answers from a layer's digit counts or from the composited pixels, for
+// decoders that get there some other way.
+std::string Checksum(const DigitCounts& fewest_zeros);
+std::string Picture(absl::string_view composite, int width);
+
+// The solution for images of |width| x |height| layers. The image text
+// doesn't say its size, so there's no kSolution.
+Solution<Input> MakeSolution(int width, int height);
+
+}  // namespace day8
+
+#endif  // DAY8_SOLUTION_H_
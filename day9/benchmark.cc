@@ -0,0 +1,18 @@
+#include <cmath>
+
+#include "common/day_benchmark.h"
+#include "day9/solution.h"
+#include "gen/generators.h"
+
+namespace {
+
+// Sizes are the number of iterations of a doubly nested loop, which ignores
+// the input and outputs its count.
+const bool registered = RegisterSolutionBenchmarks(
+    day9::kSolution, "day9/input.txt",
+    [](int64_t size) {
+      return GenerateIntcodeLoops(2, std::llround(std::sqrt(size)));
+    },
+    {1 << 10, 1 << 16, 1 << 20});
+
+}  // namespace
@@ -0,0 +1,8 @@
+#include "day9/embedded.h"
+
+namespace day9 {
+
+// What //day9 prints for input.txt, using Machine.
+static_assert(kEmbeddedPart1 == 2436480432);
+
+}  // namespace day9
@@ -0,0 +1,32 @@
+#ifndef DAY9_EMBEDDED_H_
+#define DAY9_EMBEDDED_H_
+
+#include <array>
+#include <cstdint>
+
+#include "intcode/constexpr_machine.h"
+
+// Part 1 for the checked-in input.txt, worked out by the compiler. Part 2
+// runs for hundreds of thousands of instructions, which is more than the
+// compiler's constant evaluation budget allows.
+namespace day9 {
+
+inline constexpr int64_t kEmbeddedProgram[] = {
+#include "day9/input.txt"
+};
+
+// Room for the program and the memory it uses beyond it.
+inline constexpr size_t kEmbeddedMemorySize = 2048;
+
+// The last output of the embedded program given |input|.
+constexpr int64_t RunEmbedded(int64_t input) {
+  return RunConstexprMachine<kEmbeddedMemorySize>(
+             kEmbeddedProgram, std::array<int64_t, 1>{input})
+      .last_output();
+}
+
+inline constexpr int64_t kEmbeddedPart1 = RunEmbedded(1);
+
+}  // namespace day9
+
+#endif  // DAY9_EMBEDDED_H_
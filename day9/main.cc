@@ -1,32 +1,35 @@
-#include <algorithm>
-#include <fstream>
-#include <iostream>
-
-#include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
-#include "absl/strings/numbers.h"
-#include "absl/strings/str_split.h"
-#include "absl/strings/strip.h"
-#include "absl/strings/substitute.h"
-#include "absl/types/optional.h"
+#include "common/input.h"
+#include "common/perf.h"
+#include "day9/embedded.h"
+#include "day9/solution.h"
+#include "gflags/gflags.h"
 #include "glog/logging.h"
-#include "intcode/intcode.h"
 
 int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
   google::InstallFailureSignalHandler();
   FLAGS_logtostderr = 1;
 
-  std::ifstream file(argv[1]);
-  CHECK(file);
+  if (argc < 2) {
+    // No input given: report what the compiler worked out for input.txt.
+    LOG(INFO) << "PART 1: " << day9::kEmbeddedPart1;
+    return 0;
+  }
 
-  Memory memory = ReadMemoryFromFile(file);
+  MappedFile file(argv[1]);
+  day9::Input memory = [&] {
+    ScopedPhase phase("parse");
+    return day9::Parse(file.contents());
+  }();
 
-  // Part 1: run with input 1.
-  LOG(INFO) << "PART 1: ";
-  RunMachine(memory, 1);
-  // Part 2: run with input 2.
-  LOG(INFO) << "PART 2: ";
-  RunMachine(memory, 2);
+  {
+    ScopedPhase phase("part1");
+    LOG(INFO) << "PART 1: " << day9::Part1(memory);
+  }
+  {
+    ScopedPhase phase("part2");
+    LOG(INFO) << "PART 2: " << day9::Part2(memory);
+  }
   return 0;
 }
@@ -0,0 +1,26 @@
+#include "day9/solution.h"
+
+#include "absl/strings/str_join.h"
+#include "glog/logging.h"
+
+namespace day9 {
+namespace {
+
+// Runs the program with a single |input| and returns its output,
+// comma-separated.
+std::string Run(const Memory& memory, int64_t input) {
+  Machine machine(memory);
+  machine.input() = {input};
+  CHECK(machine.Execute() == kHaltInstruction);
+  return absl::StrJoin(machine.output(), ",");
+}
+
+}  // namespace
+
+Input Parse(absl::string_view text) { return ReadMemory(text); }
+
+std::string Part1(const Input& memory) { return Run(memory, 1); }
+
+std::string Part2(const Input& memory) { return Run(memory, 2); }
+
+}  // namespace day9
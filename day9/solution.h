@@ -0,0 +1,26 @@
+#ifndef DAY9_SOLUTION_H_
+#define DAY9_SOLUTION_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+#include "intcode/intcode.h"
+
+namespace day9 {
+
+// The BOOST program.
+typedef Memory Input;
+
+Input Parse(absl::string_view text);
+// The BOOST keycode from test mode (input 1), or the malfunctioning opcodes
+// if there are any.
+std::string Part1(const Input& memory);
+// The distress signal coordinates from sensor boost mode (input 2).
+std::string Part2(const Input& memory);
+
+inline const Solution<Input> kSolution = {"day9", Parse, Part1, Part2};
+
+}  // namespace day9
+
+#endif  // DAY9_SOLUTION_H_
@@ -0,0 +1,202 @@
+#include "gen/generators.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "glog/logging.h"
+
+namespace {
+
+// A unique name for body |id| > 0 that can't collide with COM, YOU or SAN:
+// its last decimal digit followed by the rest of the id in base 36.
+std::string BodyName(int64_t id) {
+  static constexpr char kDigits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  std::string name(1, kDigits[id % 10]);
+  for (int64_t rest = id / 10; rest > 0; rest /= 36) {
+    name += kDigits[rest % 36];
+  }
+  return name;
+}
+
+// Number of bodies in a full tree |depth| orbits deep with |fan_out|
+// satellites each, stopping once it passes |limit|.
+int64_t Capacity(int depth, int fan_out, int64_t limit) {
+  int64_t total = 0;
+  int64_t level = 1;
+  for (int d = 0; d <= depth && total <= limit; ++d) {
+    total += level;
+    level = level > limit ? level : level * fan_out;
+  }
+  return total;
+}
+
+}  // namespace
+
+std::string GenerateMasses(int64_t count, int64_t min_mass, int64_t max_mass,
+                           uint64_t seed) {
+  CHECK_LE(min_mass, max_mass);
+  SeededRandom random(seed);
+  std::string text;
+  for (int64_t i = 0; i < count; ++i) {
+    absl::StrAppend(&text, random.Between(min_mass, max_mass), "\n");
+  }
+  return text;
+}
+
+std::string GenerateWirePaths(int64_t segments, int max_length,
+                              uint64_t seed) {
+  CHECK_GT(segments, 0);
+  CHECK_GT(max_length, 0);
+  static constexpr char kDirections[] = "UDLR";
+  SeededRandom random(seed);
+  std::string text;
+  for (int wire = 0; wire < 2; ++wire) {
+    for (int64_t i = 0; i < segments; ++i) {
+      if (i > 0) text += ',';
+      text += kDirections[random.Below(4)];
+      absl::StrAppend(&text, random.Between(1, max_length));
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+std::string GenerateOrbits(int64_t bodies, int depth, int fan_out,
+                           uint64_t seed) {
+  CHECK_GE(depth, 1);
+  CHECK_GE(fan_out, 1);
+  CHECK_GT(bodies, depth) << "Too few bodies for a tree " << depth
+                          << " deep.";
+  CHECK_LE(bodies, Capacity(depth, fan_out, bodies))
+      << "Too many bodies for a tree " << depth << " deep with fan-out "
+      << fan_out << ".";
+  SeededRandom random(seed);
+
+  // Body 0 is COM. Bodies 1..depth are a chain so the tree reaches its full
+  // depth; every other body orbits a random one that still has room.
+  std::vector<int> body_depth(bodies);
+  std::vector<int> satellites(bodies);
+  std::vector<std::pair<int64_t, int64_t>> orbits;
+  orbits.reserve(bodies + 1);
+  auto add = [&](int64_t center, int64_t satellite) {
+    orbits.push_back({center, satellite});
+    body_depth[satellite] = body_depth[center] + 1;
+    ++satellites[center];
+  };
+  for (int64_t body = 1; body <= depth; ++body) add(body - 1, body);
+  // Bodies that can take another satellite, each listed once.
+  std::vector<int64_t> open;
+  for (int64_t body = 0; body < depth; ++body) {
+    if (satellites[body] < fan_out) open.push_back(body);
+  }
+  for (int64_t body = depth + 1; body < bodies; ++body) {
+    // The capacity check above guarantees there is always room.
+    size_t slot = random.Below(open.size());
+    int64_t center = open[slot];
+    add(center, body);
+    if (satellites[center] >= fan_out) {
+      open[slot] = open.back();
+      open.pop_back();
+    }
+    if (body_depth[body] < depth) open.push_back(body);
+  }
+
+  // YOU and SAN (ids -1 and -2 here) orbit two different bodies that still
+  // have room, so they don't push any body past |fan_out| either.
+  std::vector<int64_t> roomy;
+  for (int64_t body = 0; body < bodies; ++body) {
+    if (satellites[body] < fan_out) roomy.push_back(body);
+  }
+  CHECK_GE(roomy.size(), 2) << "No room for YOU and SAN in a tree " << depth
+                            << " deep with fan-out " << fan_out << ".";
+  size_t you_slot = random.Below(roomy.size());
+  size_t san_slot = (you_slot + 1 + random.Below(roomy.size() - 1)) %
+                    roomy.size();
+  orbits.push_back({roomy[you_slot], -1});
+  orbits.push_back({roomy[san_slot], -2});
+
+  // Shuffle the lines, as in the real input.
+  for (size_t i = orbits.size() - 1; i > 0; --i) {
+    std::swap(orbits[i], orbits[random.Below(i + 1)]);
+  }
+  auto name = [](int64_t id) -> std::string {
+    if (id == 0) return "COM";
+    if (id == -1) return "YOU";
+    if (id == -2) return "SAN";
+    return BodyName(id);
+  };
+  std::string text;
+  for (const auto& [center, satellite] : orbits) {
+    absl::StrAppend(&text, name(center), ")", name(satellite), "\n");
+  }
+  return text;
+}
+
+std::string GenerateImage(int width, int height, int64_t layers,
+                          double transparency, uint64_t seed) {
+  CHECK_GT(width, 0);
+  CHECK_GT(height, 0);
+  SeededRandom random(seed);
+  int64_t pixels = int64_t{width} * height * layers;
+  std::string text;
+  text.reserve(pixels + 1);
+  for (int64_t i = 0; i < pixels; ++i) {
+    if (random.Chance(transparency)) {
+      text += '2';
+    } else {
+      text += (random.Next() & 1) ? '1' : '0';
+    }
+  }
+  text += '\n';
+  return text;
+}
+
+std::string GenerateAsteroidField(int rows, int cols, double density,
+                                  uint64_t seed) {
+  CHECK_GE(rows, 0);
+  CHECK_GE(cols, 0);
+  SeededRandom random(seed);
+  std::string text;
+  text.reserve(static_cast<size_t>(rows) * (cols + 1));
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      text += random.Chance(density) ? '#' : '.';
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+std::string GenerateIntcodeLoops(int depth, int64_t iterations) {
+  CHECK_GE(depth, 0);
+  CHECK_GE(iterations, 1);
+  // Layout: set the relative base to the data, then for each loop from the
+  // outside in, reset its counter (relative address k) and mark its start.
+  // The innermost body increments the total (absolute address, after the
+  // counters). Then, from the inside out, each loop decrements its counter
+  // and jumps back while it's non-zero. Finally output the total and halt.
+  const int64_t code_size = 2 + 4 * depth + 4 + 7 * depth + 2 + 1;
+  const int64_t total = code_size + depth;
+  std::vector<int64_t> program = {109, code_size};
+  std::vector<int64_t> loop_starts;
+  for (int k = 0; k < depth; ++k) {
+    // ADD immediate, immediate -> relative.
+    program.insert(program.end(), {21101, iterations, 0, k});
+    loop_starts.push_back(program.size());
+  }
+  // ADD position, immediate -> position.
+  program.insert(program.end(), {1001, total, 1, total});
+  for (int k = depth - 1; k >= 0; --k) {
+    // ADD relative, immediate -> relative.
+    program.insert(program.end(), {21201, k, -1, k});
+    // JUMP-IF-TRUE relative, immediate.
+    program.insert(program.end(), {1205, k, loop_starts[k]});
+  }
+  program.insert(program.end(), {4, total, 99});
+  CHECK_EQ(program.size(), code_size);
+  // The counters and the total.
+  program.resize(code_size + depth + 1, 0);
+  return absl::StrCat(absl::StrJoin(program, ","), "\n");
+}
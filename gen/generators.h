@@ -0,0 +1,70 @@
+#ifndef GEN_GENERATORS_H_
+#define GEN_GENERATORS_H_
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+// Synthetic puzzle inputs of any size, in the same format as the checked-in
+// inputs. Every generator is deterministic in its arguments: the same seed
+// gives byte-identical output on every platform and standard library.
+
+// Random numbers from the raw output of a 64-bit Mersenne Twister. The
+// standard distributions are implementation-defined, so they're avoided in
+// favour of plain modulo and shifts, whose small bias doesn't matter here.
+class SeededRandom {
+ public:
+  explicit SeededRandom(uint64_t seed) : engine_(seed) {}
+
+  uint64_t Next() { return engine_(); }
+  // Uniform-ish in [0, |n|); |n| must be positive.
+  uint64_t Below(uint64_t n) { return engine_() % n; }
+  // Uniform-ish in [|low|, |high|].
+  int64_t Between(int64_t low, int64_t high) {
+    return low + static_cast<int64_t>(Below(high - low + 1));
+  }
+  // True with probability |p|.
+  bool Chance(double p) {
+    return (engine_() >> 11) < static_cast<uint64_t>(p * (uint64_t{1} << 53));
+  }
+
+ private:
+  std::mt19937_64 engine_;
+};
+
+// Day 1: |count| module masses, one per line, each in [|min_mass|,
+// |max_mass|].
+std::string GenerateMasses(int64_t count, int64_t min_mass, int64_t max_mass,
+                           uint64_t seed);
+
+// Day 3: two wires of |segments| moves each ("R75,D30,..."), each move between
+// 1 and |max_length| long.
+std::string GenerateWirePaths(int64_t segments, int max_length, uint64_t seed);
+
+// Day 6: "A)B" lines, shuffled, for a tree of |bodies| bodies under COM, plus
+// YOU and SAN orbiting two different bodies. The tree is exactly |depth|
+// orbits deep and no body, counting YOU and SAN, has more than |fan_out|
+// satellites; CHECK-fails if |bodies| can't fit in those limits.
+std::string GenerateOrbits(int64_t bodies, int depth, int fan_out,
+                           uint64_t seed);
+
+// Day 8: a single line of |layers| layers of |width| x |height| digits. Each
+// pixel is transparent (2) with probability |transparency| and otherwise
+// black (0) or white (1) evenly, so |transparency| controls how many layers
+// deep the composite has to look.
+std::string GenerateImage(int width, int height, int64_t layers,
+                          double transparency, uint64_t seed);
+
+// Day 10: a |rows| x |cols| map where each cell holds an asteroid with
+// probability |density|.
+std::string GenerateAsteroidField(int rows, int cols, double density,
+                                  uint64_t seed);
+
+// An intcode program of |depth| nested counting loops, each of which runs
+// |iterations| times, around an increment of a total. The program takes no
+// input, outputs the total (|iterations|^|depth|) and halts. Loop counters
+// are addressed relative to a relative base so all three parameter modes are
+// exercised. The program text is fixed by its arguments; there's no seed.
+std::string GenerateIntcodeLoops(int depth, int64_t iterations);
+
+#endif  // GEN_GENERATORS_H_
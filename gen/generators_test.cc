@@ -0,0 +1,77 @@
+#include "gen/generators.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The shape of an orbit map: the most satellites of any body and the depth
+// of the deepest body below COM.
+struct Shape {
+  int max_fan_out = 0;
+  int depth = 0;
+  int64_t bodies = 0;
+};
+
+Shape ShapeOf(const std::string& text) {
+  absl::flat_hash_map<std::string, std::string> center_of;
+  absl::flat_hash_map<std::string, int> satellites;
+  for (absl::string_view line : absl::StrSplit(text, '\n', absl::SkipEmpty())) {
+    std::vector<std::string> names = absl::StrSplit(line, ')');
+    EXPECT_EQ(names.size(), 2) << line;
+    EXPECT_TRUE(center_of.insert({names[1], names[0]}).second)
+        << names[1] << " orbits twice";
+    ++satellites[names[0]];
+  }
+  Shape shape;
+  for (const auto& [body, count] : satellites) {
+    shape.max_fan_out = std::max(shape.max_fan_out, count);
+  }
+  for (const auto& [body, center] : center_of) {
+    if (body == "YOU" || body == "SAN") continue;
+    ++shape.bodies;
+    int depth = 0;
+    for (auto it = center_of.find(body); it != center_of.end();
+         it = center_of.find(it->second)) {
+      ++depth;
+    }
+    shape.depth = std::max(shape.depth, depth);
+  }
+  return shape;
+}
+
+TEST(GenerateOrbitsTest, NeverExceedsFanOut) {
+  for (int fan_out : {2, 3, 4}) {
+    for (int depth : {12, 40, 200}) {
+      for (uint64_t seed : {1, 2, 3}) {
+        Shape shape = ShapeOf(GenerateOrbits(2000, depth, fan_out, seed));
+        EXPECT_LE(shape.max_fan_out, fan_out)
+            << "depth " << depth << " seed " << seed;
+        EXPECT_EQ(shape.depth, depth) << "fan-out " << fan_out;
+        // Every body but COM orbits something.
+        EXPECT_EQ(shape.bodies, 1999);
+      }
+    }
+  }
+}
+
+TEST(GenerateOrbitsTest, FillsAFullTree) {
+  // 1 + 2 + 4 + 8 bodies is exactly a full binary tree 3 deep, leaving the
+  // leaves for YOU and SAN.
+  Shape shape = ShapeOf(GenerateOrbits(15, 3, 2, 7));
+  EXPECT_EQ(shape.max_fan_out, 2);
+  EXPECT_EQ(shape.depth, 3);
+}
+
+TEST(GenerateOrbitsTest, IsDeterministic) {
+  EXPECT_EQ(GenerateOrbits(500, 20, 3, 42), GenerateOrbits(500, 20, 3, 42));
+  EXPECT_NE(GenerateOrbits(500, 20, 3, 42), GenerateOrbits(500, 20, 3, 43));
+}
+
+}  // namespace
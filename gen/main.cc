@@ -0,0 +1,55 @@
+// Writes a synthetic puzzle input, e.g.
+//   gen --kind=orbits --size=1000000 --depth=5000 --fan_out=3 > orbits.txt
+
+#include <cstdio>
+#include <string>
+
+#include "gen/generators.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+DEFINE_string(kind, "",
+              "What to generate: masses (day 1), wires (day 3), orbits (day "
+              "6), image (day 8), asteroids (day 10) or intcode_loops.");
+DEFINE_int64(size, 1000,
+             "Number of masses, moves per wire, bodies or image layers.");
+DEFINE_uint64(seed, 1, "Random seed.");
+DEFINE_int32(max_length, 1000, "wires: longest move.");
+DEFINE_int32(depth, 10,
+             "orbits: depth of the tree; intcode_loops: number of nested "
+             "loops.");
+DEFINE_int32(fan_out, 4, "orbits: most satellites of any body.");
+DEFINE_int32(width, 25, "image: layer width; asteroids: map columns.");
+DEFINE_int32(height, 6, "image: layer height; asteroids: map rows.");
+DEFINE_double(density, 0.5,
+              "image: chance a pixel is transparent; asteroids: chance a "
+              "cell holds an asteroid.");
+DEFINE_int64(iterations, 10, "intcode_loops: iterations of each loop.");
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InstallFailureSignalHandler();
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = 1;
+
+  std::string text;
+  if (FLAGS_kind == "masses") {
+    text = GenerateMasses(FLAGS_size, 1000, 200000, FLAGS_seed);
+  } else if (FLAGS_kind == "wires") {
+    text = GenerateWirePaths(FLAGS_size, FLAGS_max_length, FLAGS_seed);
+  } else if (FLAGS_kind == "orbits") {
+    text = GenerateOrbits(FLAGS_size, FLAGS_depth, FLAGS_fan_out, FLAGS_seed);
+  } else if (FLAGS_kind == "image") {
+    text = GenerateImage(FLAGS_width, FLAGS_height, FLAGS_size, FLAGS_density,
+                         FLAGS_seed);
+  } else if (FLAGS_kind == "asteroids") {
+    text = GenerateAsteroidField(FLAGS_height, FLAGS_width, FLAGS_density,
+                                 FLAGS_seed);
+  } else if (FLAGS_kind == "intcode_loops") {
+    text = GenerateIntcodeLoops(FLAGS_depth, FLAGS_iterations);
+  } else {
+    LOG(FATAL) << "Unknown --kind: " << FLAGS_kind;
+  }
+  fwrite(text.data(), 1, text.size(), stdout);
+  return 0;
+}
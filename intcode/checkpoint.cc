@@ -0,0 +1,180 @@
+#include "intcode/checkpoint.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "common/input.h"
+#include "glog/logging.h"
+
+namespace {
+
+constexpr char kMagic[4] = {'I', 'C', 'K', 'P'};
+constexpr uint32_t kVersion = 1;
+
+// The page holding |address|, rounding down for negative addresses.
+int64_t PageOf(int64_t address) {
+  return address >= 0 ? address / kCheckpointPageWords
+                      : (address + 1) / kCheckpointPageWords - 1;
+}
+
+int64_t ValueAt(const Memory& memory, int64_t address) {
+  auto it = memory.find(address);
+  return it == memory.end() ? 0 : it->second;
+}
+
+class Writer {
+ public:
+  template <typename T>
+  void Put(T value) {
+    out_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  void PutValues(const Storage& values) {
+    Put<int64_t>(values.size());
+    for (int64_t value : values) Put(value);
+  }
+
+  std::string& out() { return out_; }
+
+ private:
+  std::string out_;
+};
+
+class Reader {
+ public:
+  explicit Reader(absl::string_view in) : in_(in) {}
+
+  template <typename T>
+  T Get() {
+    CHECK_GE(in_.size(), sizeof(T)) << "Checkpoint is truncated.";
+    T value;
+    memcpy(&value, in_.data(), sizeof(T));
+    in_.remove_prefix(sizeof(T));
+    return value;
+  }
+  // A count of int64 values that the rest of the checkpoint has room for.
+  int64_t GetCount() {
+    int64_t count = Get<int64_t>();
+    CHECK_GE(count, 0) << "Checkpoint is corrupt.";
+    CHECK_LE(count, in_.size() / sizeof(int64_t)) << "Checkpoint is truncated.";
+    return count;
+  }
+  Storage GetValues() {
+    Storage values(GetCount());
+    for (int64_t& value : values) value = Get<int64_t>();
+    return values;
+  }
+
+  bool done() const { return in_.empty(); }
+
+ private:
+  absl::string_view in_;
+};
+
+}  // namespace
+
+std::string SaveCheckpoint(const Machine& machine, const Memory& base) {
+  // Memory only ever gains addresses, so every address in |base| is still
+  // in the machine's memory and only those need comparing.
+  std::vector<int64_t> pages;
+  for (const auto& [address, value] : machine.memory_) {
+    if (value != ValueAt(base, address)) pages.push_back(PageOf(address));
+  }
+  std::sort(pages.begin(), pages.end());
+  pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+  Writer writer;
+  writer.out().append(kMagic, sizeof(kMagic));
+  writer.Put(kVersion);
+  writer.Put(machine.pc_);
+  writer.Put(machine.relative_base_);
+  writer.Put(machine.input_loc_);
+  writer.PutValues(*machine.input_);
+  writer.PutValues(machine.output_);
+  writer.Put<int64_t>(pages.size());
+  for (int64_t page : pages) {
+    writer.Put(page);
+    for (int64_t i = 0; i < kCheckpointPageWords; ++i) {
+      writer.Put(ValueAt(machine.memory_, page * kCheckpointPageWords + i));
+    }
+  }
+  return std::move(writer.out());
+}
+
+void RestoreCheckpoint(absl::string_view checkpoint, Machine* machine) {
+  CHECK(checkpoint.substr(0, sizeof(kMagic)) ==
+        absl::string_view(kMagic, sizeof(kMagic)))
+      << "Not a checkpoint.";
+  Reader reader(checkpoint.substr(sizeof(kMagic)));
+  uint32_t version = reader.Get<uint32_t>();
+  CHECK_EQ(version, kVersion) << "Unsupported checkpoint version.";
+  int64_t pc = reader.Get<int64_t>();
+  int64_t relative_base = reader.Get<int64_t>();
+  int64_t input_loc = reader.Get<int64_t>();
+  Storage input = reader.GetValues();
+  Storage output = reader.GetValues();
+  CHECK_GE(input_loc, 0);
+  CHECK_LE(input_loc, input.size());
+  int64_t pages = reader.GetCount();
+  // Pages are read into a copy so a bad checkpoint leaves |machine| alone.
+  Memory memory = machine->memory_;
+  for (int64_t p = 0; p < pages; ++p) {
+    int64_t page = reader.Get<int64_t>();
+    for (int64_t i = 0; i < kCheckpointPageWords; ++i) {
+      int64_t address = page * kCheckpointPageWords + i;
+      int64_t value = reader.Get<int64_t>();
+      // Unset addresses read as zero, so don't add them just to hold zero.
+      if (value != 0 || memory.contains(address)) memory[address] = value;
+    }
+  }
+  CHECK(reader.done()) << "Checkpoint has trailing data.";
+
+  machine->memory_ = std::move(memory);
+  machine->owned_input_ = std::move(input);
+  machine->input_ = &machine->owned_input_;
+  machine->output_ = std::move(output);
+  machine->pc_ = pc;
+  machine->relative_base_ = relative_base;
+  machine->input_loc_ = input_loc;
+}
+
+void WriteCheckpointFile(const std::string& path, const Machine& machine,
+                         const Memory& base) {
+  std::string checkpoint = SaveCheckpoint(machine, base);
+  std::string temp_path = path + ".tmp";
+  FILE* file = fopen(temp_path.c_str(), "wb");
+  PCHECK(file != nullptr) << "Can't open " << temp_path;
+  PCHECK(fwrite(checkpoint.data(), 1, checkpoint.size(), file) ==
+         checkpoint.size())
+      << "Can't write " << temp_path;
+  PCHECK(fflush(file) == 0);
+  PCHECK(fsync(fileno(file)) == 0);
+  PCHECK(fclose(file) == 0);
+  PCHECK(rename(temp_path.c_str(), path.c_str()) == 0)
+      << "Can't replace " << path;
+}
+
+bool ReadCheckpointFile(const std::string& path, Machine* machine) {
+  if (access(path.c_str(), F_OK) != 0) return false;
+  MappedFile file(path);
+  RestoreCheckpoint(file.contents(), machine);
+  return true;
+}
+
+HaltReason ExecuteWithCheckpoints(
+    Machine* machine, const Memory& base, const std::string& path,
+    std::chrono::steady_clock::duration interval) {
+  auto last_checkpoint = std::chrono::steady_clock::now();
+  while (true) {
+    HaltReason reason = machine->Execute(kCheckpointClockSteps);
+    if (reason != kStepLimit) return reason;
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_checkpoint >= interval) {
+      WriteCheckpointFile(path, *machine, base);
+      last_checkpoint = now;
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#ifndef INTCODE_CHECKPOINT_H_
+#define INTCODE_CHECKPOINT_H_
+
+#include <chrono>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "intcode/intcode.h"
+
+// Checkpoints of a running Machine, so a long computation can be saved and
+// resumed later, or a shared warm-up run once and restored in many
+// processes.
+//
+// A checkpoint holds the registers, the input and output, and only the pages
+// of memory that differ from a base image (normally the program the machine
+// was loaded with), so it stays small however large the memory is:
+//
+//   magic "ICKP", format version          2 x uint32
+//   pc, relative base, input location     3 x int64
+//   input count, then the values          int64, count x int64
+//   output count, then the values         int64, count x int64
+//   page count                            int64
+//   each page: index, then its words      int64, kCheckpointPageWords x int64
+//
+// Values are in the machine's byte order; checkpoints aren't meant to move
+// between architectures.
+//
+// A Machine can't safely be copied or moved, since it points at its own
+// input, so a machine to restore into should be built where it will stay,
+// e.g. with std::make_unique<Machine>(base), rather than returned by value.
+
+// Words of memory per checkpoint page.
+constexpr int64_t kCheckpointPageWords = 64;
+
+// Instructions ExecuteWithCheckpoints runs between looks at the clock.
+constexpr int64_t kCheckpointClockSteps = 1 << 20;
+
+// Serializes |machine|, storing the pages of its memory that differ from
+// |base|. A machine reading external input has that input saved, and
+// restores with it as its own input.
+std::string SaveCheckpoint(const Machine& machine, const Memory& base);
+
+// Restores |checkpoint| into |machine|, which must hold the same base memory
+// the checkpoint was saved against (as it does straight after being built
+// from it). CHECK-fails if |checkpoint| is malformed.
+void RestoreCheckpoint(absl::string_view checkpoint, Machine* machine);
+
+// Writes a checkpoint of |machine| to |path|. The file is replaced
+// atomically, so a crash mid-write leaves the previous checkpoint intact.
+void WriteCheckpointFile(const std::string& path, const Machine& machine,
+                         const Memory& base);
+
+// Restores the checkpoint at |path| into |machine|, mapping the file rather
+// than reading it. Returns false, leaving |machine| alone, if there is no
+// file at |path|.
+bool ReadCheckpointFile(const std::string& path, Machine* machine);
+
+// Executes |machine| as Machine::Execute() does, writing a checkpoint to
+// |path| whenever |interval| has passed since the last one. Combined with
+// ReadCheckpointFile at startup, this resumes after a restart from at most
+// |interval| back. The clock is only read every kCheckpointClockSteps
+// instructions, so a run shorter than that never writes a checkpoint, and a
+// short |interval| means one checkpoint every kCheckpointClockSteps.
+HaltReason ExecuteWithCheckpoints(Machine* machine, const Memory& base,
+                                  const std::string& path,
+                                  std::chrono::steady_clock::duration interval);
+
+#endif  // INTCODE_CHECKPOINT_H_
@@ -0,0 +1,126 @@
+#include "intcode/checkpoint.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "intcode/intcode.h"
+
+namespace {
+
+// Reads n, then sums n - 1 down to 0 at address 101 and outputs the total.
+// Each pass of the loop is three instructions.
+const Memory& CountdownProgram() {
+  static const Memory* program = new Memory(ReadMemory(
+      "3,100,"            // [100] = input
+      "1001,100,-1,100,"  // 2: [100] -= 1
+      "1,100,101,101,"    // 6: [101] += [100]
+      "1005,100,2,"       // 10: if [100] > 0, go to 2
+      "4,101,"            // 13: output [101]
+      "99"));
+  return *program;
+}
+
+// Reads a value and writes it far beyond the program, at both ends of the
+// address space the relative base reaches, and outputs them back.
+const Memory& ScatterProgram() {
+  static const Memory* program = new Memory(ReadMemory(
+      "3,1000,"                // [1000] = input
+      "109,-500,"              // relative base = -500
+      "21001,1000,1,0,"        // [-500] = [1000] + 1
+      "109,100500,"            // relative base = 100000
+      "21002,1000,2,0,"        // [100000] = [1000] * 2
+      "204,0,"                 // output [100000]
+      "109,-100500,"           // relative base = -500
+      "204,0,"                 // output [-500]
+      "99"));
+  return *program;
+}
+
+// The output of running |base| with |input| uninterrupted.
+Storage RunToEnd(const Memory& base, int64_t input) {
+  Machine machine(base);
+  machine.input() = {input};
+  EXPECT_EQ(machine.Execute(), kHaltInstruction);
+  return machine.output();
+}
+
+TEST(CheckpointTest, ResumesFromEveryStep) {
+  for (const Memory* base : {&CountdownProgram(), &ScatterProgram()}) {
+    Storage expected = RunToEnd(*base, 20);
+    for (int64_t steps = 0;; ++steps) {
+      SCOPED_TRACE(testing::Message() << "After " << steps << " steps");
+      auto machine = std::make_unique<Machine>(*base);
+      machine->input() = {20};
+      HaltReason reason = machine->Execute(steps);
+      std::string checkpoint = SaveCheckpoint(*machine, *base);
+
+      auto resumed = std::make_unique<Machine>(*base);
+      RestoreCheckpoint(checkpoint, resumed.get());
+      EXPECT_EQ(resumed->Execute(), kHaltInstruction);
+      EXPECT_EQ(resumed->output(), expected);
+      if (reason == kHaltInstruction) break;
+    }
+  }
+}
+
+TEST(CheckpointTest, OnlySavesChangedPages) {
+  auto machine = std::make_unique<Machine>(ScatterProgram());
+  machine->input() = {7};
+  ASSERT_EQ(machine->Execute(), kHaltInstruction);
+  std::string checkpoint = SaveCheckpoint(*machine, ScatterProgram());
+  // The header, one input, two outputs and the pages at 1000, 100000 and
+  // -500.
+  size_t header = 4 + 4 + 3 * 8 + (1 + 1) * 8 + (1 + 2) * 8 + 8;
+  EXPECT_EQ(checkpoint.size(),
+            header + 3 * (1 + kCheckpointPageWords) * sizeof(int64_t));
+}
+
+TEST(CheckpointTest, ReadingAMissingFileLeavesTheMachineAlone) {
+  auto machine = std::make_unique<Machine>(CountdownProgram());
+  EXPECT_FALSE(
+      ReadCheckpointFile(testing::TempDir() + "/no_such_checkpoint",
+                         machine.get()));
+  EXPECT_EQ(machine->memory(), CountdownProgram());
+}
+
+TEST(CheckpointTest, ResumesFromTheLastCheckpointFile) {
+  const std::string path = testing::TempDir() + "/countdown.ckp";
+  unlink(path.c_str());
+  // Long enough for the clock to be checked a few times; with a zero
+  // interval, every check writes a checkpoint.
+  const int64_t n = kCheckpointClockSteps;
+  Storage expected = RunToEnd(CountdownProgram(), n);
+  ASSERT_EQ(expected, Storage{n * (n - 1) / 2});
+
+  auto machine = std::make_unique<Machine>(CountdownProgram());
+  machine->input() = {n};
+  EXPECT_EQ(ExecuteWithCheckpoints(machine.get(), CountdownProgram(), path,
+                                   std::chrono::steady_clock::duration(0)),
+            kHaltInstruction);
+  EXPECT_EQ(machine->output(), expected);
+  EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+
+  // The last checkpoint was written partway through, before any output.
+  auto resumed = std::make_unique<Machine>(CountdownProgram());
+  ASSERT_TRUE(ReadCheckpointFile(path, resumed.get()));
+  EXPECT_TRUE(resumed->output().empty());
+  EXPECT_EQ(resumed->Execute(), kHaltInstruction);
+  EXPECT_EQ(resumed->output(), expected);
+}
+
+TEST(CheckpointTest, ShortRunsWriteNoCheckpoint) {
+  const std::string path = testing::TempDir() + "/short.ckp";
+  unlink(path.c_str());
+  auto machine = std::make_unique<Machine>(CountdownProgram());
+  machine->input() = {1000};
+  EXPECT_EQ(ExecuteWithCheckpoints(machine.get(), CountdownProgram(), path,
+                                   std::chrono::steady_clock::duration(0)),
+            kHaltInstruction);
+  EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+}  // namespace
@@ -0,0 +1,52 @@
+#include "intcode/constexpr_machine.h"
+
+#include "glog/logging.h"
+
+void ConstexprMachineFailure(const char* what) { LOG(FATAL) << what; }
+
+// The examples from the puzzles, checked at build time. Each expected value
+// is what Machine gives for the same program and input.
+namespace {
+
+// Day 2: 1 + 1 = 2, and the worked example that leaves 3500 at address 0.
+constexpr int64_t kAddExample[] = {1, 0, 0, 0, 99};
+static_assert(RunConstexprMachine<5>(kAddExample).memory(0) == 2);
+constexpr int64_t kDay2Example[] = {1, 9, 10, 3, 2, 3, 11, 0, 99, 30, 40, 50};
+static_assert(RunConstexprMachine<12>(kDay2Example).memory(0) == 3500);
+
+// Day 5: immediate mode, and the program that compares its input to 8,
+// outputting 999, 1000 or 1001 for below, equal and above.
+constexpr int64_t kImmediateExample[] = {1002, 4, 3, 4, 33};
+static_assert(RunConstexprMachine<5>(kImmediateExample).memory(4) == 99);
+constexpr int64_t kCompareTo8[] = {
+    3,    21,   1008, 21, 8,   20, 1005, 20,  22,  107,  8,    21,
+    20,   1006, 20,   31, 1106, 0, 36,   98,  0,   0,    1002, 21,
+    125,  20,   4,    20, 1105, 1, 46,   104, 999, 1105, 1,    46,
+    1101, 1000, 1,    20, 4,   20, 1105, 1,   46,  98,   99};
+static_assert(RunConstexprMachine<64>(kCompareTo8, std::array<int64_t, 1>{7})
+                  .last_output() == 999);
+static_assert(RunConstexprMachine<64>(kCompareTo8, std::array<int64_t, 1>{8})
+                  .last_output() == 1000);
+static_assert(RunConstexprMachine<64>(kCompareTo8, std::array<int64_t, 1>{9})
+                  .last_output() == 1001);
+
+// Day 9: a quine using the relative base, and large numbers.
+constexpr int64_t kQuine[] = {109,  1,   204, -1,  1001, 100, 1, 100,
+                              1008, 100, 16,  101, 1006, 101, 0, 99};
+constexpr bool OutputsItself() {
+  auto machine = RunConstexprMachine<128>(kQuine);
+  if (machine.output_size() != 16) return false;
+  for (size_t i = 0; i < 16; ++i) {
+    if (machine.output(i) != kQuine[i]) return false;
+  }
+  return true;
+}
+static_assert(OutputsItself());
+constexpr int64_t kSixteenDigits[] = {1102, 34915192, 34915192, 7, 4, 7, 99, 0};
+static_assert(RunConstexprMachine<8>(kSixteenDigits).last_output() ==
+              1219070632396864);
+constexpr int64_t kLargeNumber[] = {104, 1125899906842624, 99};
+static_assert(RunConstexprMachine<3>(kLargeNumber).last_output() ==
+              1125899906842624);
+
+}  // namespace
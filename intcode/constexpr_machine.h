@@ -0,0 +1,238 @@
+#ifndef INTCODE_CONSTEXPR_MACHINE_H_
+#define INTCODE_CONSTEXPR_MACHINE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "intcode/intcode.h"
+
+// Called when a ConstexprMachine hits an error. It isn't constexpr, so an
+// error during constant evaluation fails the build; at run time it
+// LOG(FATAL)s with |what|.
+void ConstexprMachineFailure(const char* what);
+
+// The same interpreter as Machine, but usable in constant expressions, so
+// results for programs and inputs known at build time can be worked out by
+// the compiler. Memory is a fixed std::array of |kMemorySize| words (zero
+// beyond the program, as Machine's memory reads), and input and output hold
+// at most |kMaxIo| values each.
+template <size_t kMemorySize, size_t kMaxIo = 64>
+class ConstexprMachine {
+ public:
+  // Loads |program| at address zero.
+  template <size_t kProgramSize>
+  constexpr explicit ConstexprMachine(const int64_t (&program)[kProgramSize]) {
+    static_assert(kProgramSize <= kMemorySize, "Program doesn't fit.");
+    for (size_t i = 0; i < kProgramSize; ++i) memory_[i] = program[i];
+  }
+
+  // Loads the |size| words at |program| at address zero, for programs only
+  // known at run time.
+  constexpr ConstexprMachine(const int64_t* program, size_t size) {
+    if (size > kMemorySize) ConstexprMachineFailure("Program doesn't fit.");
+    for (size_t i = 0; i < size; ++i) memory_[i] = program[i];
+  }
+
+  // Appends |value| to the program input.
+  constexpr void AddInput(int64_t value) {
+    if (input_size_ == kMaxIo) ConstexprMachineFailure("Input is full.");
+    input_[input_size_++] = value;
+  }
+
+  // Executes what is in memory. As with Machine, kWaitingForInput means more
+  // input is needed before calling Execute again.
+  constexpr HaltReason Execute() {
+    NoTrace no_trace;
+    return Execute(no_trace);
+  }
+
+  // As Execute(), reporting each step to |sink|, which has TraceSink's
+  // methods. Only usable in constant expressions if they are constexpr.
+  template <typename Sink>
+  constexpr HaltReason Execute(Sink& sink) {
+    // GCC limits the iterations of any one loop during constant evaluation
+    // (-fconstexpr-loop-limit), so the steps are run in bounded batches.
+    for (;;) {
+      for (int step = 0; step < kStepsPerBatch; ++step) {
+        if (Load(pc_) == kHalt) return kHaltInstruction;
+        if (!Step(sink)) return kWaitingForInput;
+      }
+    }
+  }
+
+  // Memory, modified during execution.
+  constexpr int64_t& memory(int64_t address) { return Address(address); }
+  constexpr int64_t memory(int64_t address) const { return Load(address); }
+
+  // Program output.
+  constexpr size_t output_size() const { return output_size_; }
+  constexpr int64_t output(size_t index) const {
+    if (index >= output_size_) ConstexprMachineFailure("No such output.");
+    return output_[index];
+  }
+  // The last value output, which is usually the answer.
+  constexpr int64_t last_output() const {
+    if (output_size_ == 0) ConstexprMachineFailure("No output.");
+    return output_[output_size_ - 1];
+  }
+
+ private:
+  static constexpr int kStepsPerBatch = 1 << 16;
+
+  // A sink that ignores everything, for untraced runs.
+  struct NoTrace {
+    constexpr void OnInstruction(int64_t, int64_t) {}
+    constexpr void OnWrite(int64_t, int64_t) {}
+    constexpr void OnInput(int64_t) {}
+    constexpr void OnOutput(int64_t) {}
+  };
+
+  constexpr int64_t& Address(int64_t address) {
+    if (address < 0 || address >= static_cast<int64_t>(kMemorySize)) {
+      ConstexprMachineFailure("Address out of range.");
+    }
+    return memory_[address];
+  }
+  constexpr int64_t Load(int64_t address) const {
+    if (address < 0 || address >= static_cast<int64_t>(kMemorySize)) {
+      ConstexprMachineFailure("Address out of range.");
+    }
+    return memory_[address];
+  }
+
+  // The |index|th parameter mode of |instruction|.
+  static constexpr ParameterMode Mode(int64_t instruction, int index) {
+    instruction /= 100;
+    for (int i = 0; i < index; ++i) instruction /= 10;
+    int64_t mode = instruction % 10;
+    if (mode > kRelative) ConstexprMachineFailure("Unknown mode.");
+    return static_cast<ParameterMode>(mode);
+  }
+
+  // Reads from the address at pc_ with the given mode and increments pc_.
+  constexpr int64_t Read(ParameterMode mode) {
+    int64_t parameter = Load(pc_++);
+    switch (mode) {
+      case kPosition:
+        return Load(parameter);
+      case kImmediate:
+        return parameter;
+      case kRelative:
+        return Load(parameter + relative_base_);
+    }
+    ConstexprMachineFailure("Unknown mode.");
+    return 0;
+  }
+
+  // Stores value to the address at pc_ with the given mode and increments pc_.
+  template <typename Sink>
+  constexpr void Store(int64_t value, ParameterMode mode, Sink& sink) {
+    int64_t address = Load(pc_++);
+    switch (mode) {
+      case kPosition:
+        sink.OnWrite(address, value);
+        Address(address) = value;
+        return;
+      case kImmediate:
+        ConstexprMachineFailure("Writes will never use immediate mode.");
+        return;
+      case kRelative:
+        sink.OnWrite(address + relative_base_, value);
+        Address(address + relative_base_) = value;
+        return;
+    }
+    ConstexprMachineFailure("Unknown mode.");
+  }
+
+  // Executes the instruction at pc_. Returns false, with pc_ unchanged, if it
+  // needs input that isn't there yet.
+  template <typename Sink>
+  constexpr bool Step(Sink& sink) {
+    int64_t instruction = Load(pc_);
+    if (instruction <= 0) ConstexprMachineFailure("Not an instruction.");
+    sink.OnInstruction(pc_, instruction % 100);
+    ++pc_;
+    switch (instruction % 100) {
+      case kAdd: {
+        int64_t val1 = Read(Mode(instruction, 0));
+        int64_t val2 = Read(Mode(instruction, 1));
+        Store(val1 + val2, Mode(instruction, 2), sink);
+        return true;
+      }
+      case kMult: {
+        int64_t val1 = Read(Mode(instruction, 0));
+        int64_t val2 = Read(Mode(instruction, 1));
+        Store(val1 * val2, Mode(instruction, 2), sink);
+        return true;
+      }
+      case kStore: {
+        if (input_loc_ >= input_size_) {
+          --pc_;
+          return false;
+        }
+        sink.OnInput(input_[input_loc_]);
+        Store(input_[input_loc_++], Mode(instruction, 0), sink);
+        return true;
+      }
+      case kOutput: {
+        int64_t val = Read(Mode(instruction, 0));
+        sink.OnOutput(val);
+        if (output_size_ == kMaxIo) ConstexprMachineFailure("Output is full.");
+        output_[output_size_++] = val;
+        return true;
+      }
+      case kJumpIfTrue:
+      case kJumpIfFalse: {
+        int64_t val = Read(Mode(instruction, 0));
+        int64_t jump_to = Read(Mode(instruction, 1));
+        // Matches Machine, which only jumps on "true" for positive values.
+        bool matches = instruction % 100 == kJumpIfTrue ? val > 0 : val == 0;
+        if (matches) pc_ = jump_to;
+        return true;
+      }
+      case kLessThan:
+      case kEquals: {
+        int64_t val1 = Read(Mode(instruction, 0));
+        int64_t val2 = Read(Mode(instruction, 1));
+        bool result = instruction % 100 == kEquals ? val1 == val2 : val1 < val2;
+        Store(result ? 1 : 0, Mode(instruction, 2), sink);
+        return true;
+      }
+      case kAdjustRelativeBase:
+        relative_base_ += Read(Mode(instruction, 0));
+        return true;
+    }
+    ConstexprMachineFailure("Unknown opcode.");
+    return false;
+  }
+
+  std::array<int64_t, kMemorySize> memory_ = {};
+  std::array<int64_t, kMaxIo> input_ = {};
+  std::array<int64_t, kMaxIo> output_ = {};
+  size_t input_size_ = 0;
+  size_t output_size_ = 0;
+
+  // Program counter, starts at zero.
+  int64_t pc_ = 0;
+  // Relative base register, used for relative-base parameter modes.
+  int64_t relative_base_ = 0;
+  // Current read location in input.
+  size_t input_loc_ = 0;
+};
+
+// Runs |program| with |inputs| until it halts and returns the machine, for
+// reading its memory or output. Fails if the program wants more input.
+template <size_t kMemorySize, size_t kProgramSize, size_t kInputs = 0>
+constexpr ConstexprMachine<kMemorySize> RunConstexprMachine(
+    const int64_t (&program)[kProgramSize],
+    const std::array<int64_t, kInputs>& inputs = {}) {
+  ConstexprMachine<kMemorySize> machine(program);
+  for (int64_t input : inputs) machine.AddInput(input);
+  if (machine.Execute() != kHaltInstruction) {
+    ConstexprMachineFailure("Program is waiting for input.");
+  }
+  return machine;
+}
+
+#endif  // INTCODE_CONSTEXPR_MACHINE_H_
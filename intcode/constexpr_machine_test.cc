@@ -0,0 +1,134 @@
+#include "intcode/constexpr_machine.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/input.h"
+#include "gtest/gtest.h"
+#include "intcode/intcode.h"
+#include "intcode/trace.h"
+
+namespace {
+
+// Enough for every program below and the memory it uses beyond itself.
+constexpr size_t kMemorySize = 4096;
+typedef ConstexprMachine<kMemorySize> TestMachine;
+
+std::vector<int64_t> ReadProgram(const std::string& path) {
+  MappedFile file(path);
+  return ParseInts(file.contents());
+}
+
+Memory ToMemory(const std::vector<int64_t>& program) {
+  Memory memory;
+  for (size_t i = 0; i < program.size(); ++i) memory[i] = program[i];
+  return memory;
+}
+
+// Runs |program| with |inputs| on both Machine and ConstexprMachine, and
+// expects them to stop for the same reason with the same output, the same
+// memory and the same trace.
+void ExpectSameAsMachine(const std::vector<int64_t>& program,
+                         const std::vector<int64_t>& inputs) {
+  TraceWriter expected_trace;
+  Machine machine(ToMemory(program));
+  machine.input() = inputs;
+  machine.SetTraceSink(&expected_trace);
+  HaltReason expected = machine.Execute();
+
+  TraceWriter trace;
+  // Too large for the stack once kMemorySize words are in it.
+  auto constexpr_machine =
+      std::make_unique<TestMachine>(program.data(), program.size());
+  for (int64_t input : inputs) constexpr_machine->AddInput(input);
+  EXPECT_EQ(constexpr_machine->Execute(trace), expected);
+
+  const Storage& output = machine.output();
+  ASSERT_EQ(constexpr_machine->output_size(), output.size());
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_EQ(constexpr_machine->output(i), output[i]) << "Output " << i;
+  }
+  for (const auto& [address, value] : machine.memory()) {
+    EXPECT_EQ(constexpr_machine->memory(address), value)
+        << "Address " << address;
+  }
+  auto divergence =
+      FindTraceDivergence(expected_trace.contents(), trace.contents());
+  EXPECT_FALSE(divergence.has_value())
+      << "Traces differ at instruction " << divergence->instruction;
+}
+
+TEST(ConstexprMachineTest, MatchesMachineOnSmallPrograms) {
+  struct Case {
+    std::vector<int64_t> program;
+    std::vector<int64_t> inputs;
+  };
+  const std::vector<int64_t> compare_to_8 = {
+      3,    21,   1008, 21, 8,   20, 1005, 20,  22,  107,  8,    21,
+      20,   1006, 20,   31, 1106, 0, 36,   98,  0,   0,    1002, 21,
+      125,  20,   4,    20, 1105, 1, 46,   104, 999, 1105, 1,    46,
+      1101, 1000, 1,    20, 4,   20, 1105, 1,   46,  98,   99};
+  const std::vector<Case> cases = {
+      // Add and multiply, in position and immediate modes.
+      {{1, 9, 10, 3, 2, 3, 11, 0, 99, 30, 40, 50}, {}},
+      {{1002, 4, 3, 4, 33}, {}},
+      {{1101, 100, -1, 4, 0}, {}},
+      // Input and output.
+      {{3, 0, 4, 0, 99}, {-42}},
+      // Equals and less than, in both modes.
+      {{3, 9, 8, 9, 10, 9, 4, 9, 99, -1, 8}, {8}},
+      {{3, 9, 7, 9, 10, 9, 4, 9, 99, -1, 8}, {5}},
+      {{3, 9, 7, 9, 10, 9, 4, 9, 99, -1, 8}, {8}},
+      {{3, 3, 1108, -1, 8, 3, 4, 3, 99}, {9}},
+      {{3, 3, 1107, -1, 8, 3, 4, 3, 99}, {7}},
+      // Jumps, in both modes.
+      {{3, 12, 6, 12, 15, 1, 13, 14, 13, 4, 13, 99, -1, 0, 1, 9}, {0}},
+      {{3, 3, 1105, -1, 9, 1101, 0, 0, 12, 4, 12, 99, 1}, {3}},
+      {compare_to_8, {7}},
+      {compare_to_8, {8}},
+      {compare_to_8, {9}},
+      // The relative base, for reads and for writes.
+      {{109, 1,   204, -1,  1001, 100, 1, 100,
+        1008, 100, 16,  101, 1006, 101, 0, 99},
+       {}},
+      {{109, 50, 203, 0, 204, 0, 21101, 3, 4, 1, 204, 1, 99}, {17}},
+      // Large numbers.
+      {{1102, 34915192, 34915192, 7, 4, 7, 99, 0}, {}},
+      {{104, 1125899906842624, 99}, {}},
+      // Runs out of input.
+      {{3, 0, 3, 1, 99}, {1}},
+  };
+  for (const Case& c : cases) {
+    SCOPED_TRACE(testing::PrintToString(c.program));
+    ExpectSameAsMachine(c.program, c.inputs);
+  }
+}
+
+TEST(ConstexprMachineTest, MatchesMachineOnDay2) {
+  std::vector<int64_t> program = ReadProgram("day2/input.txt");
+  for (auto [noun, verb] : {std::make_pair(12, 2), std::make_pair(0, 0),
+                            std::make_pair(52, 96), std::make_pair(99, 99)}) {
+    SCOPED_TRACE(testing::Message() << "noun " << noun << ", verb " << verb);
+    program[1] = noun;
+    program[2] = verb;
+    ExpectSameAsMachine(program, {});
+  }
+}
+
+TEST(ConstexprMachineTest, MatchesMachineOnDay5) {
+  std::vector<int64_t> program = ReadProgram("day5/input.txt");
+  ExpectSameAsMachine(program, {1});
+  ExpectSameAsMachine(program, {5});
+}
+
+TEST(ConstexprMachineTest, MatchesMachineOnDay9) {
+  std::vector<int64_t> program = ReadProgram("day9/input.txt");
+  ExpectSameAsMachine(program, {1});
+  // Part 2 runs for hundreds of thousands of instructions, more than the
+  // compiler would evaluate, so this is the only place it's checked.
+  ExpectSameAsMachine(program, {2});
+}
+
+}  // namespace
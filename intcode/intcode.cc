@@ -1,22 +1,10 @@
 #include "intcode/intcode.h"
 
+#include "common/input.h"
 #include "glog/logging.h"
 
 namespace {
 
-enum OpCode {
-  kAdd = 1,
-  kMult = 2,
-  kStore = 3,
-  kOutput = 4,
-  kJumpIfTrue = 5,
-  kJumpIfFalse = 6,
-  kLessThan = 7,
-  kEquals = 8,
-  kAdjustRelativeBase = 9,
-  kHalt = 99,
-};
-
 class Instruction {
  public:
   explicit Instruction(int64_t value) {
@@ -78,20 +66,21 @@ bool MatchesBoolean(int64_t value, bool b) {
 
 }  // namespace
 
-Memory ReadMemoryFromFile(std::ifstream& file) {
+Memory ReadMemory(absl::string_view text) {
+  std::vector<int64_t> values = ParseInts(text);
   Memory memory;
-  int64_t cursor = 0;
-  std::string line;
-  while (std::getline(file, line)) {
-    for (auto s : absl::StrSplit(line, ",")) {
-      int64_t val;
-      CHECK(absl::SimpleAtoi(s, &val));
-      memory.insert({cursor++, val});
-    }
+  memory.reserve(values.size());
+  for (int64_t i = 0; i < values.size(); ++i) {
+    memory.insert({i, values[i]});
   }
   return memory;
 }
 
+Memory ReadMemoryFromFile(const std::string& path) {
+  MappedFile file(path);
+  return ReadMemory(file.contents());
+}
+
 void RunMachine(Memory memory, int64_t input_value) {
   Machine machine(memory);
   machine.input() = {input_value};
@@ -124,12 +113,14 @@ void Machine::Store(int64_t value, ParameterMode mode) {
   int64_t address = memory_[pc_++];
   switch (mode) {
     case kPosition:
+      if (trace_ != nullptr) trace_->OnWrite(address, value);
       memory_[address] = value;
       break;
     case kImmediate:
       CHECK(false) << "Writes will never use immediate mode.";
       break;
     case kRelative:
+      if (trace_ != nullptr) trace_->OnWrite(address + relative_base_, value);
       memory_[address + relative_base_] = value;
       break;
     default:
@@ -138,7 +129,13 @@ void Machine::Store(int64_t value, ParameterMode mode) {
 }
 
 HaltReason Machine::Execute() {
-  while (memory_[pc_] != kHalt) {
+  return Execute(std::numeric_limits<int64_t>::max());
+}
+
+HaltReason Machine::Execute(int64_t max_steps) {
+  for (int64_t step = 0; memory_[pc_] != kHalt; ++step) {
+    if (step == max_steps) return kStepLimit;
+    if (trace_ != nullptr) trace_->OnInstruction(pc_, memory_[pc_] % 100);
     Instruction i(Read(kImmediate));
     VLOG(1) << "[" << pc_ - 1 << "] Executing op: " << OpName(i.op());
     switch (i.op()) {
@@ -162,11 +159,13 @@ HaltReason Machine::Execute() {
         }
         auto val = (*input_)[input_loc_++];
         VLOG(2) << "Read " << val << " from input.";
+        if (trace_ != nullptr) trace_->OnInput(val);
         Store(val, i.mode(0));
         break;
       }
       case kOutput: {
         auto val = Read(i.mode(0));
+        if (trace_ != nullptr) trace_->OnOutput(val);
         output_.push_back(val);
         break;
       }
@@ -1,10 +1,14 @@
 #ifndef INTCODE_INTCODE_H_
 #define INTCODE_INTCODE_H_
 
-#include <fstream>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
-#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "intcode/trace_sink.h"
 
 // Storage, like tape.
 typedef std::vector<int64_t> Storage;
@@ -16,7 +20,24 @@ enum HaltReason {
   // Input exhausted, call Execute() again to retry.
   kWaitingForInput,
   // Executed a Halt instruction, program is complete.
-  kHaltInstruction
+  kHaltInstruction,
+  // Executed the number of instructions asked for, call Execute() again to
+  // continue.
+  kStepLimit
+};
+
+// Instruction opcodes, the low two decimal digits of an instruction.
+enum OpCode {
+  kAdd = 1,
+  kMult = 2,
+  kStore = 3,
+  kOutput = 4,
+  kJumpIfTrue = 5,
+  kJumpIfFalse = 6,
+  kLessThan = 7,
+  kEquals = 8,
+  kAdjustRelativeBase = 9,
+  kHalt = 99,
 };
 
 // The type of parameter, when loading/storing.
@@ -30,8 +51,10 @@ enum ParameterMode {
   kRelative = 2,
 };
 
-// Reads Memory from an input file.
-Memory ReadMemoryFromFile(std::ifstream& file);
+// Reads Memory from comma-separated |text|.
+Memory ReadMemory(absl::string_view text);
+// Reads Memory from the file at |path|.
+Memory ReadMemoryFromFile(const std::string& path);
 
 // Helper to run a machine with memory and a single input value and print the
 // resulting output.
@@ -47,6 +70,8 @@ class Machine {
   // Executes what is in memory. If kWaitingForInput is returned, call Execute
   // again to continue running the program when more input is available.
   HaltReason Execute();
+  // As Execute(), but stops with kStepLimit after |max_steps| instructions.
+  HaltReason Execute(int64_t max_steps);
 
   // Memory, modified during execution.
   Memory& memory() { return memory_; }
@@ -58,7 +83,16 @@ class Machine {
   // for another Machine.
   Storage& output() { return output_; }
 
+  // Reports every step of execution to |sink|, or stops reporting if null.
+  // |sink| must outlive its use.
+  void SetTraceSink(TraceSink* sink) { trace_ = sink; }
+
  private:
+  // Checkpoints save and restore the registers as well as the memory and I/O.
+  friend std::string SaveCheckpoint(const Machine& machine, const Memory& base);
+  friend void RestoreCheckpoint(absl::string_view checkpoint,
+                                Machine* machine);
+
   // Reads from the address at pc_ with the given mode and increments pc_.
   int64_t Read(ParameterMode parameter_mode);
   // Stores value to the address at pc_ with the given mode and increments pc_.
@@ -77,6 +111,8 @@ class Machine {
   int64_t relative_base_ = 0;
   // Current read location in input.
   int64_t input_loc_ = 0;
+  // Where execution is reported, if anywhere.
+  TraceSink* trace_ = nullptr;
 };
 
 #endif  // INTCODE_INTCODE_H_
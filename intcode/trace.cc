@@ -0,0 +1,207 @@
+#include "intcode/trace.h"
+
+#include "absl/strings/str_cat.h"
+#include "glog/logging.h"
+
+namespace {
+
+constexpr char kMagic[4] = {'I', 'C', 'T', 'R'};
+constexpr char kVersion = 1;
+
+// Record bytes other than opcodes, which are all below 100.
+constexpr unsigned char kWriteRecord = 0xFD;
+constexpr unsigned char kInputRecord = 0xFE;
+constexpr unsigned char kOutputRecord = 0xFF;
+
+// Buffered bytes at which a file-backed TraceWriter writes them out.
+constexpr size_t kFlushBytes = 1 << 20;
+
+// Maps signed values to unsigned ones with small magnitudes staying small:
+// 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// a - b and a + b, wrapping rather than overflowing, so deltas between any
+// two addresses round-trip.
+int64_t WrappingSub(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) -
+                              static_cast<uint64_t>(b));
+}
+int64_t WrappingAdd(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) +
+                              static_cast<uint64_t>(b));
+}
+
+}  // namespace
+
+std::string DescribeTraceEvent(const TraceEvent& event) {
+  switch (event.kind) {
+    case kInstructionEvent:
+      return absl::StrCat("opcode ", event.value, " at ", event.address);
+    case kWriteEvent:
+      return absl::StrCat("write ", event.value, " to [", event.address, "]");
+    case kInputEvent:
+      return absl::StrCat("input ", event.value);
+    case kOutputEvent:
+      return absl::StrCat("output ", event.value);
+  }
+  return "unknown event";
+}
+
+TraceWriter::TraceWriter() {
+  buffer_.append(kMagic, sizeof(kMagic));
+  buffer_ += kVersion;
+}
+
+TraceWriter::TraceWriter(const std::string& path) : TraceWriter() {
+  file_ = fopen(path.c_str(), "wb");
+  PCHECK(file_ != nullptr) << "Can't open " << path;
+  buffer_.reserve(kFlushBytes + 64);
+}
+
+TraceWriter::~TraceWriter() {
+  if (file_ == nullptr) return;
+  Flush();
+  PCHECK(fclose(file_) == 0);
+}
+
+void TraceWriter::OnInstruction(int64_t pc, int64_t opcode) {
+  CHECK_GE(opcode, 0);
+  CHECK_LT(opcode, 100);
+  buffer_ += static_cast<char>(opcode);
+  PutVarint(WrappingSub(pc, last_pc_));
+  last_pc_ = pc;
+  MaybeFlush();
+}
+
+void TraceWriter::OnWrite(int64_t address, int64_t value) {
+  buffer_ += static_cast<char>(kWriteRecord);
+  PutVarint(WrappingSub(address, last_write_));
+  PutVarint(value);
+  last_write_ = address;
+}
+
+void TraceWriter::OnInput(int64_t value) {
+  buffer_ += static_cast<char>(kInputRecord);
+  PutVarint(value);
+}
+
+void TraceWriter::OnOutput(int64_t value) {
+  buffer_ += static_cast<char>(kOutputRecord);
+  PutVarint(value);
+}
+
+void TraceWriter::PutVarint(int64_t value) {
+  uint64_t bits = ZigZag(value);
+  while (bits >= 0x80) {
+    buffer_ += static_cast<char>(bits | 0x80);
+    bits >>= 7;
+  }
+  buffer_ += static_cast<char>(bits);
+}
+
+void TraceWriter::MaybeFlush() {
+  if (file_ != nullptr && buffer_.size() >= kFlushBytes) Flush();
+}
+
+void TraceWriter::Flush() {
+  PCHECK(fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size())
+      << "Can't write trace.";
+  buffer_.clear();
+}
+
+TraceReader::TraceReader(absl::string_view trace)
+    : next_(trace.data()), end_(trace.data() + trace.size()) {
+  CHECK(trace.size() > sizeof(kMagic) &&
+        absl::string_view(next_, sizeof(kMagic)) ==
+            absl::string_view(kMagic, sizeof(kMagic)))
+      << "Not a trace.";
+  CHECK_EQ(next_[sizeof(kMagic)], kVersion) << "Unsupported trace version.";
+  next_ += sizeof(kMagic) + 1;
+}
+
+bool TraceReader::Next(TraceEvent* event) {
+  if (next_ == end_) return false;
+  unsigned char record = *next_++;
+  switch (record) {
+    case kWriteRecord:
+      event->kind = kWriteEvent;
+      last_write_ = WrappingAdd(last_write_, GetVarint());
+      event->address = last_write_;
+      event->value = GetVarint();
+      return true;
+    case kInputRecord:
+      event->kind = kInputEvent;
+      event->address = 0;
+      event->value = GetVarint();
+      return true;
+    case kOutputRecord:
+      event->kind = kOutputEvent;
+      event->address = 0;
+      event->value = GetVarint();
+      return true;
+    default:
+      CHECK_LT(record, 100) << "Bad trace record.";
+      event->kind = kInstructionEvent;
+      last_pc_ = WrappingAdd(last_pc_, GetVarint());
+      event->address = last_pc_;
+      event->value = record;
+      return true;
+  }
+}
+
+int64_t TraceReader::GetVarint() {
+  uint64_t bits = 0;
+  for (int shift = 0;; shift += 7) {
+    CHECK(next_ != end_) << "Trace is truncated.";
+    CHECK_LT(shift, 64) << "Bad trace varint.";
+    unsigned char byte = *next_++;
+    bits |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) return UnZigZag(bits);
+  }
+}
+
+absl::optional<TraceDivergence> FindTraceDivergence(
+    absl::string_view first, absl::string_view second) {
+  TraceReader first_reader(first);
+  TraceReader second_reader(second);
+  // The instruction both traces are in, once they've started one.
+  int64_t instruction = -1;
+  int64_t pc = -1;
+  TraceEvent first_event;
+  TraceEvent second_event;
+  while (true) {
+    bool has_first = first_reader.Next(&first_event);
+    bool has_second = second_reader.Next(&second_event);
+    if (!has_first && !has_second) return absl::nullopt;
+    if (has_first && has_second && first_event == second_event) {
+      if (first_event.kind == kInstructionEvent) {
+        ++instruction;
+        pc = first_event.address;
+      }
+      continue;
+    }
+    TraceDivergence divergence;
+    // Differing instruction events are a new instruction; anything else is
+    // part of the current one.
+    bool starts_instruction =
+        (has_first && first_event.kind == kInstructionEvent) ||
+        (has_second && second_event.kind == kInstructionEvent);
+    if (starts_instruction || instruction < 0) {
+      divergence.instruction = instruction + 1;
+      divergence.pc = -1;
+    } else {
+      divergence.instruction = instruction;
+      divergence.pc = pc;
+    }
+    if (has_first) divergence.first = first_event;
+    if (has_second) divergence.second = second_event;
+    return divergence;
+  }
+}
@@ -0,0 +1,120 @@
+#ifndef INTCODE_TRACE_H_
+#define INTCODE_TRACE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "intcode/trace_sink.h"
+
+// Compact binary traces of intcode executions, for checking that a faster
+// engine does exactly what Machine does.
+//
+// A trace is the magic "ICTR" and a one-byte format version, then one record
+// per event. Each record starts with a byte saying what it is: the opcode
+// (1-9 or 99) for an instruction, or kWriteRecord, kInputRecord or
+// kOutputRecord. Then come its fields as zigzag varints:
+//
+//   instruction   pc - the previous instruction's pc
+//   write         address - the previous write's address, value
+//   input         value
+//   output        value
+//
+// Straight-line code and nearby writes take one byte per delta, so most
+// instructions cost two or three bytes.
+
+enum TraceEventKind {
+  kInstructionEvent,
+  kWriteEvent,
+  kInputEvent,
+  kOutputEvent,
+};
+
+struct TraceEvent {
+  TraceEventKind kind = kInstructionEvent;
+  // The instruction's pc, or the address written; zero for I/O.
+  int64_t address = 0;
+  // The opcode, or the value written, input or output.
+  int64_t value = 0;
+
+  bool operator==(const TraceEvent& other) const {
+    return kind == other.kind && address == other.address &&
+           value == other.value;
+  }
+  bool operator!=(const TraceEvent& other) const { return !(*this == other); }
+};
+
+// Describes |event| for people, e.g. "write 12 to [225]".
+std::string DescribeTraceEvent(const TraceEvent& event);
+
+// A TraceSink that encodes what it is sent. Records are buffered and written
+// out in large blocks, so recording costs a few nanoseconds an event.
+class TraceWriter : public TraceSink {
+ public:
+  // Keeps the trace in memory; see contents().
+  TraceWriter();
+  // Writes the trace to the file at |path|, replacing it.
+  explicit TraceWriter(const std::string& path);
+  // Flushes and closes the file, if any.
+  ~TraceWriter() override;
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  void OnInstruction(int64_t pc, int64_t opcode) override;
+  void OnWrite(int64_t address, int64_t value) override;
+  void OnInput(int64_t value) override;
+  void OnOutput(int64_t value) override;
+
+  // The trace so far, when kept in memory.
+  const std::string& contents() const { return buffer_; }
+
+ private:
+  void PutVarint(int64_t value);
+  // Writes out the buffer if it is going to a file and has grown large.
+  void MaybeFlush();
+  void Flush();
+
+  FILE* file_ = nullptr;
+  std::string buffer_;
+  int64_t last_pc_ = 0;
+  int64_t last_write_ = 0;
+};
+
+// Decodes a trace, an event at a time.
+class TraceReader {
+ public:
+  // |trace| must outlive the reader. CHECK-fails if it isn't a trace.
+  explicit TraceReader(absl::string_view trace);
+
+  // Sets |event| to the next event and returns true, or returns false at the
+  // end of the trace. CHECK-fails on a malformed record.
+  bool Next(TraceEvent* event);
+
+ private:
+  int64_t GetVarint();
+
+  const char* next_;
+  const char* end_;
+  int64_t last_pc_ = 0;
+  int64_t last_write_ = 0;
+};
+
+// Where two traces first differ.
+struct TraceDivergence {
+  // The instruction, counting from zero, that the traces differ in.
+  int64_t instruction = 0;
+  // Its pc, or -1 if the traces differ on the instruction itself.
+  int64_t pc = -1;
+  // The differing events, or nullopt where that trace ended first.
+  absl::optional<TraceEvent> first;
+  absl::optional<TraceEvent> second;
+};
+
+// Compares two traces event by event. Returns nullopt if they are the same.
+absl::optional<TraceDivergence> FindTraceDivergence(absl::string_view first,
+                                                    absl::string_view second);
+
+#endif  // INTCODE_TRACE_H_
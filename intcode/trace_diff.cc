@@ -0,0 +1,137 @@
+// Checks that two intcode engines execute a program identically, by
+// recording a trace of each and reporting the first event where they differ.
+//
+//   trace_diff --program=day9/input.txt --input=2
+//
+// runs the program under Machine and under ConstexprMachine (at run time).
+// With --first_trace and --second_trace, the traces are written to those
+// files rather than kept in memory, for long runs; without --program, those
+// two existing traces are compared instead, so runs recorded elsewhere (say,
+// a canary with tracing on) can be checked offline.
+//
+// Exits with status 1 if the traces differ.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "common/input.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "intcode/constexpr_machine.h"
+#include "intcode/intcode.h"
+#include "intcode/trace.h"
+
+DEFINE_string(program, "", "Intcode program to run under both engines.");
+DEFINE_string(input, "", "Comma-separated input values for the program.");
+DEFINE_string(first_trace, "",
+              "File for Machine's trace, or the first trace to compare.");
+DEFINE_string(second_trace, "",
+              "File for ConstexprMachine's trace, or the second trace to "
+              "compare.");
+
+namespace {
+
+// Words of memory and I/O values the ConstexprMachine engine has room for.
+constexpr size_t kMemoryWords = 1 << 20;
+constexpr size_t kMaxIo = 1 << 16;
+typedef ConstexprMachine<kMemoryWords, kMaxIo> BigConstexprMachine;
+
+std::vector<int64_t> ParseInput(absl::string_view text) {
+  std::vector<int64_t> values;
+  for (absl::string_view field :
+       absl::StrSplit(text, ',', absl::SkipWhitespace())) {
+    int64_t value;
+    CHECK(absl::SimpleAtoi(field, &value)) << "Bad input value: " << field;
+    values.push_back(value);
+  }
+  return values;
+}
+
+// A writer to |path|, or in memory if it's empty.
+std::unique_ptr<TraceWriter> MakeWriter(const std::string& path) {
+  return path.empty() ? std::make_unique<TraceWriter>()
+                      : std::make_unique<TraceWriter>(path);
+}
+
+// Runs |program| on |input| under Machine, into |writer|.
+void RunMachine(const std::vector<int64_t>& program,
+                const std::vector<int64_t>& input, TraceWriter* writer) {
+  Memory memory;
+  for (int64_t i = 0; i < program.size(); ++i) memory[i] = program[i];
+  Machine machine(memory);
+  machine.input() = input;
+  machine.SetTraceSink(writer);
+  HaltReason reason = machine.Execute();
+  LOG_IF(WARNING, reason != kHaltInstruction)
+      << "Machine stopped waiting for input.";
+}
+
+// Runs |program| on |input| under ConstexprMachine, into |writer|.
+void RunConstexprMachine(const std::vector<int64_t>& program,
+                         const std::vector<int64_t>& input,
+                         TraceWriter* writer) {
+  // Far too big for the stack.
+  auto machine =
+      std::make_unique<BigConstexprMachine>(program.data(), program.size());
+  for (int64_t value : input) machine->AddInput(value);
+  HaltReason reason = machine->Execute(*writer);
+  LOG_IF(WARNING, reason != kHaltInstruction)
+      << "ConstexprMachine stopped waiting for input.";
+}
+
+std::string Describe(const absl::optional<TraceEvent>& event) {
+  return event ? DescribeTraceEvent(*event) : "end of trace";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = 1;
+
+  absl::optional<TraceDivergence> divergence;
+  if (!FLAGS_program.empty()) {
+    std::vector<int64_t> program;
+    {
+      MappedFile file(FLAGS_program);
+      program = ParseInts(file.contents());
+    }
+    std::vector<int64_t> input = ParseInput(FLAGS_input);
+    std::unique_ptr<TraceWriter> first = MakeWriter(FLAGS_first_trace);
+    std::unique_ptr<TraceWriter> second = MakeWriter(FLAGS_second_trace);
+    RunMachine(program, input, first.get());
+    RunConstexprMachine(program, input, second.get());
+    if (FLAGS_first_trace.empty() && FLAGS_second_trace.empty()) {
+      divergence = FindTraceDivergence(first->contents(), second->contents());
+    } else {
+      CHECK(!FLAGS_first_trace.empty() && !FLAGS_second_trace.empty())
+          << "Set both --first_trace and --second_trace, or neither.";
+      // Closing the writers flushes the files.
+      first.reset();
+      second.reset();
+    }
+  }
+  if (FLAGS_program.empty() || !FLAGS_first_trace.empty()) {
+    CHECK(!FLAGS_first_trace.empty() && !FLAGS_second_trace.empty())
+        << "Set --program, or --first_trace and --second_trace to compare.";
+    MappedFile first(FLAGS_first_trace);
+    MappedFile second(FLAGS_second_trace);
+    divergence = FindTraceDivergence(first.contents(), second.contents());
+  }
+
+  if (!divergence) {
+    absl::PrintF("Traces match.\n");
+    return 0;
+  }
+  absl::PrintF("First divergence in instruction %d", divergence->instruction);
+  if (divergence->pc >= 0) absl::PrintF(" (pc %d)", divergence->pc);
+  absl::PrintF(":\n  first:  %s\n  second: %s\n",
+               Describe(divergence->first), Describe(divergence->second));
+  return 1;
+}
@@ -0,0 +1,21 @@
+#ifndef INTCODE_TRACE_SINK_H_
+#define INTCODE_TRACE_SINK_H_
+
+#include <cstdint>
+
+// Receives every step of an intcode execution, in order, for recording or
+// checking it. An engine reports each instruction as it starts, then the
+// input it reads, the memory it writes and the output it makes. An
+// instruction that stops to wait for input is reported again when it is
+// retried.
+class TraceSink {
+ public:
+  virtual ~TraceSink() = default;
+
+  virtual void OnInstruction(int64_t pc, int64_t opcode) = 0;
+  virtual void OnWrite(int64_t address, int64_t value) = 0;
+  virtual void OnInput(int64_t value) = 0;
+  virtual void OnOutput(int64_t value) = 0;
+};
+
+#endif  // INTCODE_TRACE_SINK_H_
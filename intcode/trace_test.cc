@@ -0,0 +1,182 @@
+#include "intcode/trace.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/input.h"
+#include "gtest/gtest.h"
+#include "intcode/intcode.h"
+
+namespace {
+
+constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+
+// Sends |events| to |writer| in order.
+void Record(const std::vector<TraceEvent>& events, TraceWriter* writer) {
+  for (const TraceEvent& event : events) {
+    switch (event.kind) {
+      case kInstructionEvent:
+        writer->OnInstruction(event.address, event.value);
+        break;
+      case kWriteEvent:
+        writer->OnWrite(event.address, event.value);
+        break;
+      case kInputEvent:
+        writer->OnInput(event.value);
+        break;
+      case kOutputEvent:
+        writer->OnOutput(event.value);
+        break;
+    }
+  }
+}
+
+std::vector<TraceEvent> ReadAll(absl::string_view trace) {
+  std::vector<TraceEvent> events;
+  TraceReader reader(trace);
+  TraceEvent event;
+  while (reader.Next(&event)) events.push_back(event);
+  return events;
+}
+
+TraceEvent Instruction(int64_t pc, int64_t opcode) {
+  return {kInstructionEvent, pc, opcode};
+}
+TraceEvent Write(int64_t address, int64_t value) {
+  return {kWriteEvent, address, value};
+}
+TraceEvent Input(int64_t value) { return {kInputEvent, 0, value}; }
+TraceEvent Output(int64_t value) { return {kOutputEvent, 0, value}; }
+
+// Every kind of event, with deltas of both signs and of every size up to the
+// widest, which wrap around.
+std::vector<TraceEvent> AwkwardEvents() {
+  return {
+      Instruction(0, kAdd),       Write(3, 7),
+      Instruction(4, kMult),      Write(-1, -1),
+      Instruction(2, kStore),     Input(kMin),
+      Write(kMax, kMin),          Instruction(kMax, kOutput),
+      Output(kMax),               Instruction(kMin, kJumpIfTrue),
+      Instruction(-5, kEquals),   Write(kMin, kMax),
+      Write(kMax, 0),             Write(0, 1),
+      Instruction(1 << 30, kLessThan),
+      Instruction(0, kAdjustRelativeBase),
+      Input(0),                   Output(-1),
+      Instruction(kMax, kHalt),
+  };
+}
+
+TEST(TraceTest, RoundTripsInMemory) {
+  TraceWriter writer;
+  Record(AwkwardEvents(), &writer);
+  EXPECT_EQ(ReadAll(writer.contents()), AwkwardEvents());
+}
+
+TEST(TraceTest, RoundTripsThroughAFile) {
+  const std::string path = testing::TempDir() + "/trace_test.trace";
+  std::vector<TraceEvent> events;
+  // Enough to flush the buffer to the file more than once.
+  for (int i = 0; i < 1000000; ++i) {
+    events.push_back(Instruction(i * 4, kAdd));
+    events.push_back(Write(i % 2 ? -i : i, int64_t{i} << 32));
+  }
+  {
+    TraceWriter writer(path);
+    Record(events, &writer);
+  }
+  MappedFile file(path);
+  EXPECT_EQ(ReadAll(file.contents()), events);
+}
+
+TEST(TraceTest, StraightLineCodeIsSmall) {
+  TraceWriter writer;
+  size_t header = writer.contents().size();
+  for (int pc = 0; pc < 400; pc += 4) writer.OnInstruction(pc, kAdd);
+  // The opcode, then a one-byte delta.
+  EXPECT_EQ(writer.contents().size() - header, 100 * 2);
+}
+
+TEST(TraceTest, IdenticalTracesDontDiverge) {
+  TraceWriter first;
+  TraceWriter second;
+  Record(AwkwardEvents(), &first);
+  Record(AwkwardEvents(), &second);
+  EXPECT_FALSE(FindTraceDivergence(first.contents(), second.contents()));
+}
+
+TEST(TraceTest, FindsADifferentWrite) {
+  std::vector<TraceEvent> events = AwkwardEvents();
+  TraceWriter first;
+  Record(events, &first);
+  // The write made by the second instruction, at pc 4.
+  events[3].value = 12;
+  TraceWriter second;
+  Record(events, &second);
+
+  auto divergence = FindTraceDivergence(first.contents(), second.contents());
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->instruction, 1);
+  EXPECT_EQ(divergence->pc, 4);
+  EXPECT_EQ(divergence->first, Write(-1, -1));
+  EXPECT_EQ(divergence->second, Write(-1, 12));
+}
+
+TEST(TraceTest, FindsADifferentInstruction) {
+  std::vector<TraceEvent> events = AwkwardEvents();
+  TraceWriter first;
+  Record(events, &first);
+  events[4].address = 3;
+  TraceWriter second;
+  Record(events, &second);
+
+  auto divergence = FindTraceDivergence(first.contents(), second.contents());
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->instruction, 2);
+  EXPECT_EQ(divergence->pc, -1);
+  EXPECT_EQ(divergence->first, Instruction(2, kStore));
+  EXPECT_EQ(divergence->second, Instruction(3, kStore));
+}
+
+TEST(TraceTest, FindsATraceThatEndsEarly) {
+  std::vector<TraceEvent> events = AwkwardEvents();
+  TraceWriter first;
+  Record(events, &first);
+  events.pop_back();
+  TraceWriter second;
+  Record(events, &second);
+
+  auto divergence = FindTraceDivergence(first.contents(), second.contents());
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->first, Instruction(kMax, kHalt));
+  EXPECT_FALSE(divergence->second);
+}
+
+TEST(TraceTest, FindsWhereTwoMachinesDiffer) {
+  // Outputs its input plus 1, then the same again; the second program adds
+  // 2 the second time.
+  Memory program = ReadMemory("3,20,1001,20,1,21,4,21,1001,20,1,21,4,21,99");
+  Memory changed = program;
+  changed[10] = 2;
+  TraceWriter first;
+  TraceWriter second;
+  for (auto [memory, writer] : {std::make_pair(&program, &first),
+                                std::make_pair(&changed, &second)}) {
+    Machine machine(*memory);
+    machine.input() = {5};
+    machine.SetTraceSink(writer);
+    ASSERT_EQ(machine.Execute(), kHaltInstruction);
+  }
+
+  auto divergence = FindTraceDivergence(first.contents(), second.contents());
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->instruction, 3);
+  EXPECT_EQ(divergence->pc, 8);
+  EXPECT_EQ(divergence->first, Write(21, 6));
+  EXPECT_EQ(divergence->second, Write(21, 7));
+}
+
+}  // namespace
@@ -3,5 +3,8 @@
 day=$1
 mkdir ${day}
 cp template/* ${day}/
-sed -i.bak -e "s/\${day}/${day}/" ${day}/BUILD
-rm ${day}/BUILD.bak
+# ${DAY} is the upper-case day, for header guards.
+sed -i.bak -e "s/\${day}/${day}/g" -e "s/\${DAY}/${day^^}/g" \
+  ${day}/BUILD ${day}/*.h ${day}/*.cc
+rm ${day}/*.bak
+echo "Add ${day} to all/run.cc and all/BUILD to include it in //all:run."
@@ -0,0 +1,11 @@
+#include "common/day_benchmark.h"
+#include "${day}/solution.h"
+
+namespace {
+
+// To benchmark scaled inputs too, pass a generator from //gen (and add the
+// dependency) along with the sizes to generate.
+const bool registered = RegisterSolutionBenchmarks(
+    ${day}::kSolution, "${day}/input.txt", nullptr, {});
+
+}  // namespace
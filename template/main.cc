@@ -1,30 +1,28 @@
-#include <execution>
-#include <fstream>
-#include <numeric>
-
-#include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
-#include "absl/strings/numbers.h"
-#include "absl/strings/str_replace.h"
-#include "absl/strings/str_split.h"
-#include "absl/strings/strip.h"
-#include "absl/strings/substitute.h"
-#include "absl/types/optional.h"
+#include "common/input.h"
+#include "common/perf.h"
+#include "${day}/solution.h"
+#include "gflags/gflags.h"
 #include "glog/logging.h"
 
 int main(int argc, char** argv) {
-  google::InstallFailureSignalHandler();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
   FLAGS_logtostderr = 1;
 
-  std::ifstream file(argv[1]);
-  CHECK(file);
+  MappedFile file(argv[1]);
+  ${day}::Input input = [&] {
+    ScopedPhase phase("parse");
+    return ${day}::Parse(file.contents());
+  }();
 
-  std::string line;
-  while (std::getline(file, line)) {
+  {
+    ScopedPhase phase("part1");
+    LOG(INFO) << "PART 1: " << ${day}::Part1(input);
+  }
+  {
+    ScopedPhase phase("part2");
+    LOG(INFO) << "PART 2: " << ${day}::Part2(input);
   }
-
-  LOG(INFO) << "PART 1: ";
-  LOG(INFO) << "PART 2: ";
   return 0;
 }
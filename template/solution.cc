@@ -0,0 +1,21 @@
+#include "${day}/solution.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/strip.h"
+#include "absl/strings/substitute.h"
+#include "absl/types/optional.h"
+#include "common/input.h"
+#include "glog/logging.h"
+
+namespace ${day} {
+
+Input Parse(absl::string_view text) { return SplitLines(text); }
+
+std::string Part1(const Input& input) { return ""; }
+
+std::string Part2(const Input& input) { return ""; }
+
+}  // namespace ${day}
@@ -0,0 +1,23 @@
+#ifndef ${DAY}_SOLUTION_H_
+#define ${DAY}_SOLUTION_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/solution.h"
+
+namespace ${day} {
+
+// Lines of the input.
+typedef std::vector<absl::string_view> Input;
+
+Input Parse(absl::string_view text);
+std::string Part1(const Input& input);
+std::string Part2(const Input& input);
+
+inline const Solution<Input> kSolution = {"${day}", Parse, Part1, Part2};
+
+}  // namespace ${day}
+
+#endif  // ${DAY}_SOLUTION_H_
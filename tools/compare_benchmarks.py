@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Fails if benchmarks got slower than a stored baseline.
+
+Both files are Google Benchmark JSON output, e.g. from
+
+  bazel run -c opt //day6:day6_benchmark -- \
+      --benchmark_out=/tmp/day6.json --benchmark_out_format=json
+
+then
+
+  tools/compare_benchmarks.py baselines/day6.json /tmp/day6.json
+
+prints each benchmark's change and exits with status 1 if any is slower than
+the baseline by more than --threshold. With --update, the current results
+replace the baseline instead (after printing the comparison).
+
+With --benchmark_repetitions, the "mean" aggregates are compared (or whatever
+--aggregate names); otherwise each benchmark's single run is.
+"""
+
+import argparse
+import json
+import shutil
+import sys
+
+# Nanoseconds per Google Benchmark time unit.
+_UNITS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric, aggregate):
+    """Returns {benchmark name: time in ns} from a benchmark JSON file."""
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    has_aggregates = any(b.get("run_type") == "aggregate" for b in benchmarks)
+    times = {}
+    for b in benchmarks:
+        if b.get("error_occurred"):
+            continue
+        if has_aggregates:
+            if b.get("aggregate_name") != aggregate:
+                continue
+            name = b["run_name"]
+        else:
+            name = b["name"]
+        times[name] = b[metric] * _UNITS[b.get("time_unit", "ns")]
+    return times
+
+
+def format_ns(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= _UNITS[unit]:
+            return "%.3g %s" % (ns / _UNITS[unit], unit)
+    return "%.3g ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="Stored baseline JSON.")
+    parser.add_argument("current", help="JSON from the run to check.")
+    parser.add_argument(
+        "--threshold", type=float, default=0.10,
+        help="Largest allowed slowdown, as a fraction (default 0.10).")
+    parser.add_argument(
+        "--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+        help="Which time to compare (default cpu_time).")
+    parser.add_argument(
+        "--aggregate", default="mean",
+        help="Aggregate to compare when there are repetitions (default mean).")
+    parser.add_argument(
+        "--update", action="store_true",
+        help="Replace the baseline with the current results.")
+    args = parser.parse_args()
+
+    current = load_times(args.current, args.metric, args.aggregate)
+    try:
+        baseline = load_times(args.baseline, args.metric, args.aggregate)
+    except FileNotFoundError:
+        if not args.update:
+            raise
+        baseline = {}
+
+    regressions = []
+    width = max([len(name) for name in current] + [9])
+    print("%-*s %12s %12s %9s" % (width, "Benchmark", "Baseline", "Current",
+                                  "Change"))
+    for name, time in current.items():
+        if name not in baseline:
+            print("%-*s %12s %12s %9s" % (width, name, "-", format_ns(time),
+                                          "new"))
+            continue
+        change = time / baseline[name] - 1
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name,
+                                              format_ns(baseline[name]),
+                                              format_ns(time), change * 100,
+                                              flag))
+    for name in baseline:
+        if name not in current:
+            print("%-*s %12s %12s %9s" % (width, name,
+                                          format_ns(baseline[name]), "-",
+                                          "missing"))
+
+    if args.update:
+        shutil.copyfile(args.current, args.baseline)
+        print("Updated %s." % args.baseline)
+        return 0
+    if regressions:
+        print("%d benchmark(s) slower than the baseline by more than %.0f%%: %s"
+              % (len(regressions), args.threshold * 100,
+                 ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())